@@ -0,0 +1,74 @@
+/****************************************************************
+ * AGENDASCANNER.HPP
+ *
+ * This file contains the specialized scanner of the MATSim
+ * activity chains.
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file AgendaScanner.hpp
+ *  \brief Allocation-free scanner of the person and act elements of a MATSim agenda.
+ */
+
+#ifndef AGENDASCANNER_HPP_
+#define AGENDASCANNER_HPP_
+
+#include <string>
+
+#include "Data.hpp"
+#include "SaxParser.hpp"
+
+//! \brief Scanner of the persons and activities of a memory mapped MATSim agenda.
+/*!
+  The scanner works directly on the mapped file: element and attribute names
+  are compared in place and the values are converted with parseInt,
+  parseFloorFloat and parseTime, without any copy or allocation. It only
+  supports the restricted MATSim person/act schema, so the libxml++
+  VBSaxParser must be used for anything unusual: isSupported() checks the
+  prolog (internal DTD subset, non ASCII-compatible encodings) and scan()
+  throws on the constructs found in the document (entities or character
+  references, CDATA sections).
+ */
+class AgendaScanner {
+
+private:
+
+	MappedFile   _file;        //!< mapping of the agenda
+	const char*  _end;         //!< end of the mapping
+
+	//! Parse the attributes of a person element and start the person.
+	const char* scanPerson(const char* p, AgendaBuilder& aBuilder) const;
+
+	//! Parse the attributes of an act element and add the activity.
+	const char* scanActivity(const char* p, AgendaBuilder& aBuilder) const;
+
+	//! Read the next attribute of an element.
+	/*!
+	  \return false at the end of the start tag, p then points after the '>' and aEmpty
+	  is true if the element is empty (<... />)
+	 */
+	bool nextAttribute(const char*& p, const char*& aName, size_t& aNameLength,
+			const char*& aValue, const char*& aValueEnd, bool& aEmpty) const;
+
+	//! Throw a std::runtime_error reporting the position in the file.
+	void error(const char* p, const std::string& aMessage) const;
+
+public:
+
+	//! Constructor, maps the agenda.
+	explicit AgendaScanner(const std::string& aFilename);
+
+	//! Check that the prolog of the agenda only uses constructs handled by the scanner.
+	bool isSupported() const;
+
+	//! Scan the whole agenda, feeding the persons to an AgendaBuilder.
+	/*!
+	  Throws a std::runtime_error on a malformed agenda or a construct not
+	  handled by the scanner, the persons already fed being kept.
+	 */
+	void scan(AgendaBuilder& aBuilder) const;
+
+};
+
+#endif /* AGENDASCANNER_HPP_ */
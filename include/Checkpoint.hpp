@@ -0,0 +1,88 @@
+/****************************************************************
+ * CHECKPOINT.HPP
+ *
+ * This file contains the checkpoint files related classes and
+ * methods.
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file Checkpoint.hpp
+ *  \brief Checkpoint of the simulation state.
+ *
+ *  A checkpoint is a directory <checkpoint.dir>/tick_<tick> holding
+ *  - process_<rank>.bin, the CheckpointPart of every process, written in
+ *    parallel by the processes;
+ *  - checkpoint.props, the global state of the simulation, written by the
+ *    process 0 once all the parts are written, so a checkpoint without it
+ *    is incomplete.
+ */
+
+#ifndef CHECKPOINT_HPP_
+#define CHECKPOINT_HPP_
+
+#include <string>
+#include <vector>
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include "Individual.hpp"
+
+const int CHECKPOINT_VERSION = 3;   //!< current version of the checkpoint parts
+
+//! State of the simulation on a process.
+struct CheckpointPart {
+
+	int                             version;          //!< CHECKPOINT_VERSION
+	int                             rank;             //!< rank of the process
+	int                             n_proc;           //!< number of processes
+	std::string                     engine;           //!< state of the random engine of the process
+	std::vector<IndividualPackage>  agents;           //!< agents of the process
+	std::vector<int>                locations;        //!< location (x, y) of every agent
+	std::vector<int>                infected_nodes;   //!< (node id, infected count) of the infected nodes of the process
+
+	//! Serializing procedure of the part.
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int aVersion) {
+		ar &version;
+		ar &rank;
+		ar &n_proc;
+		ar &engine;
+		ar &agents;
+		ar &locations;
+		ar &infected_nodes;
+	}
+
+};
+
+
+//! Return the directory of the checkpoint of a tick.
+/*!
+  \param aDir the checkpoints directory (checkpoint.dir)
+  \param aTick the tick of the checkpoint
+ */
+std::string getCheckpointDir(const std::string& aDir, int aTick);
+
+
+//! Write the part of a process.
+/*!
+  \param aDir the directory of the checkpoint
+  \param aPart the part
+
+  Throws a std::runtime_error if the part cannot be written.
+ */
+void writeCheckpointPart(const std::string& aDir, const CheckpointPart& aPart);
+
+
+//! Read the part of a process.
+/*!
+  \param aDir the directory of the checkpoint
+  \param aRank the process that wrote the part
+  \param aPart the part read
+
+  Throws a std::runtime_error if the part cannot be read.
+ */
+void readCheckpointPart(const std::string& aDir, int aRank, CheckpointPart& aPart);
+
+#endif /* CHECKPOINT_HPP_ */
@@ -23,12 +23,16 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+#include <cstdint>
 #include <boost/lexical_cast.hpp>
 #include <boost/tokenizer.hpp>
 #include <boost/algorithm/string.hpp>
 
 #include "Network.hpp"
-#include "tinyxml2.hpp"
 
 //! \brief Singleton class for the Data class.
 template <typename T>
@@ -82,6 +86,59 @@ private:
 //! Initialize the singleton to NULL.
 template <typename T> T *Singleton<T>::_singleton = NULL;
 
+//! \brief Mapping between the original ids of the nodes and the generated ones.
+/*!
+  The generated id of a node is its position in the network file. The mapping
+  is stored as a sorted flat array of (original id, generated id) pairs and a
+  dense vector of original ids indexed by the generated ones.
+ */
+class NodeIdMap {
+
+private:
+
+	std::vector<std::pair<int, int> > _orig_to_new;   //!< (original id, generated id) pairs sorted by original id
+	std::vector<int>                  _new_to_orig;   //!< original ids indexed by generated id
+
+public:
+
+	//! Default constructor.
+	NodeIdMap() {}
+
+	//! Constructor.
+	/*!
+	  \param aOrigIds the original ids of the nodes, in the order of the network file
+	 */
+	explicit NodeIdMap(const std::vector<int>& aOrigIds);
+
+	//! Return the generated id of a node.
+	/*!
+	  \param aOrigId the original id of the node
+
+	  Throws a std::out_of_range if the node is unknown.
+	 */
+	int at(int aOrigId) const;
+
+	//! Return 1 if the node is known, 0 otherwise.
+	size_t count(int aOrigId) const;
+
+	//! Return the original id of a node.
+	int getOrigId(int aNewId) const {
+		return _new_to_orig.at(aNewId);
+	}
+
+	//! Return the original ids of the nodes, indexed by generated id.
+	const std::vector<int>& getOrigIds() const {
+		return _new_to_orig;
+	}
+
+	//! Return the number of nodes.
+	size_t size() const {
+		return _new_to_orig.size();
+	}
+
+};
+
+
 //! \brief A data class.
 /*!
  A data class reading and producing all the inputs required by
@@ -95,8 +152,7 @@ private:
 
 	Network            _network;                     //!< network.
 	repast::Properties _props;                       //!< properties of simulation.
-	std::map<int, int> _map_nodes_orig_id_new_id;  //!< map linking the original id of a node to the generated one
-	std::map<int, int> _map_nodes_new_id_orig_id;  //!< map linking the original id of a node to the generated one
+	NodeIdMap          _map_nodes_ids;               //!< map linking the original id of a node to the generated one
 
 public:
 
@@ -127,8 +183,37 @@ public:
 	~Data() {};
 
 	//! Read the road network (MATSim format).
+	/*!
+	  Only the process 0 reads the nodes ids, either from the binary cache of
+	  the network (see network.cache) or by streaming the xml file, and then
+	  broadcasts them to the other processes.
+	 */
 	void read_network();
 
+	//! Read the original ids of the nodes of a MATSim network file, in file order.
+	/*!
+	  \param aFilename the network file
+	  \param aOrigIds the vector receiving the ids
+	  \return false if the nodes could not be read completely (the ids read being kept)
+	 */
+	static bool read_network_node_ids(const std::string& aFilename, std::vector<int>& aOrigIds);
+
+	//! Return the range of nodes handled by a process.
+	/*!
+	  The nodes are split in contiguous ranges of (nearly) equal size, the
+	  last process taking the remaining nodes.
+
+	  \param aNNodes the number of nodes of the network
+	  \param aNProc the number of processes
+	  \param aProc the process
+	  \param aFirst the first node handled by the process
+	  \param aLast the last node handled by the process (aLast < aFirst if none)
+	 */
+	static void getNodesRange(int aNNodes, int aNProc, int aProc, int& aFirst, int& aLast);
+
+	//! Return the process handling a node (see getNodesRange).
+	static int getNodeProcess(int aNodeId, int aNNodes, int aNProc);
+
 	//! Return the road network.
 	/*!
       \return a road network
@@ -137,8 +222,9 @@ public:
 		return _network;
 	}
 
-	const std::map<int, int>& getMapNodesOrigIdNewId() const {
-		return _map_nodes_orig_id_new_id;
+	//! Return the mapping between the original and generated nodes ids.
+	const NodeIdMap& getMapNodesOrigIdNewId() const {
+		return _map_nodes_ids;
 	}
 
 };
@@ -186,6 +272,43 @@ public :
 /////////////////////////////
 
 
+//! \brief Read-only memory mapping of a whole file.
+class MappedFile {
+
+private:
+
+	int         _fd;     //!< file descriptor
+	size_t      _size;   //!< size of the file
+	const char* _data;   //!< start of the mapping
+
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+public:
+
+	//! Constructor, maps the file.
+	/*!
+	  \param aFilename the file to map
+	  \param aSequential true if the file will be read sequentially (read-ahead hint)
+
+	  Throws a std::runtime_error if the file cannot be mapped.
+	 */
+	explicit MappedFile(const std::string& aFilename, bool aSequential = false);
+
+	//! Destructor, unmaps the file.
+	~MappedFile();
+
+	const char* data() const {
+		return _data;
+	}
+
+	size_t size() const {
+		return _size;
+	}
+
+};
+
+
 //! Convert a given time formatted as hh:mm:ss to the number of seconds since midnight.
 /*!
   \param aTime a string that represents an hour in the hh:mm:ss format
@@ -195,6 +318,148 @@ public :
 long timeToSec(const std::string &aTime );
 
 
+//! Parse a signed integer.
+/*!
+  \param aBegin start of the characters to parse
+  \param aEnd end of the characters to parse (excluded)
+  \param aValue the parsed value
+
+  \return false if [aBegin, aEnd[ is not an integer
+ */
+inline bool parseInt(const char* aBegin, const char* aEnd, int& aValue) {
+
+	bool negative = aBegin != aEnd && *aBegin == '-';
+	if( negative || (aBegin != aEnd && *aBegin == '+') ) aBegin++;
+	if( aBegin == aEnd || aEnd - aBegin > 10 ) return false;
+
+	long value = 0;
+	for( const char* c = aBegin; c != aEnd; c++ ) {
+		if( *c < '0' || *c > '9' ) return false;
+		value = value * 10 + (*c - '0');
+	}
+	if( value > 2147483647L + negative ) return false;
+	aValue = (int)(negative ? -value : value);
+	return true;
+
+}
+
+
+//! Parse a decimal number (without exponent) rounded down, as floor(lexical_cast<float>).
+/*!
+  \param aBegin start of the characters to parse
+  \param aEnd end of the characters to parse (excluded)
+  \param aValue the parsed value rounded down
+
+  \return false if [aBegin, aEnd[ is not a decimal number
+ */
+inline bool parseFloorFloat(const char* aBegin, const char* aEnd, int& aValue) {
+
+	static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18 };
+
+	bool negative = aBegin != aEnd && *aBegin == '-';
+	if( negative || (aBegin != aEnd && *aBegin == '+') ) aBegin++;
+
+	long long mantissa = 0;
+	int n_digits = 0;
+	int n_decimals = -1;
+	for( const char* c = aBegin; c != aEnd; c++ ) {
+		if( *c == '.' && n_decimals < 0 ) {
+			n_decimals = 0;
+		} else if( *c >= '0' && *c <= '9' ) {
+			mantissa = mantissa * 10 + (*c - '0');
+			if( ++n_digits > 18 ) return false;
+			if( n_decimals >= 0 ) n_decimals++;
+		} else {
+			return false;
+		}
+	}
+	if( n_digits == 0 ) return false;
+
+	double value = (double)mantissa / pow10[n_decimals < 0 ? 0 : n_decimals];
+	float rounded = (float)(negative ? -value : value);
+	if( rounded >= 2147483647.0f || rounded < -2147483648.0f ) return false;
+	aValue = (int)std::floor(rounded);
+	return true;
+
+}
+
+
+//! Parse a time formatted as hh:mm:ss into the number of seconds since midnight.
+/*!
+  \param aBegin start of the characters to parse
+  \param aEnd end of the characters to parse (excluded)
+  \param aValue the number of seconds elapsed since midnight
+
+  \return false if [aBegin, aEnd[ is not formatted as hh:mm:ss
+ */
+inline bool parseTime(const char* aBegin, const char* aEnd, long& aValue) {
+
+	long fields[3] = { 0, 0, 0 };
+	int  n_fields  = 0;
+	int  n_digits  = 0;
+	for( const char* c = aBegin; c != aEnd; c++ ) {
+		if( *c >= '0' && *c <= '9' ) {
+			fields[n_fields] = fields[n_fields] * 10 + (*c - '0');
+			if( ++n_digits > 9 ) return false;
+		} else if( *c == ':' && n_digits > 0 && n_fields < 2 ) {
+			n_fields++;
+			n_digits = 0;
+		} else {
+			return false;
+		}
+	}
+	if( n_fields != 2 || n_digits == 0 ) return false;
+
+	aValue = fields[0] * 3600 + fields[1] * 60 + fields[2];
+	return true;
+
+}
+
+
+//! SplitMix64 mixing function.
+inline uint64_t splitmix64(uint64_t aValue) {
+	aValue += 0x9e3779b97f4a7c15ULL;
+	aValue = (aValue ^ (aValue >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	aValue = (aValue ^ (aValue >> 27)) * 0x94d049bb133111ebULL;
+	return aValue ^ (aValue >> 31);
+}
+
+
+//! Check if a person belongs to the sampled population.
+/*!
+  The decision only depends on the person id and the seed, so the sampled
+  population does not depend on the number of processes nor on the order in
+  which the persons are read. For a given seed, the persons kept with a sample
+  size are also kept with any larger sample size.
+
+  \param aPersonId id of the person
+  \param aSampleSize the proportion of persons to keep
+  \param aSeed the sampling seed (see getSampleSeed)
+
+  \return true if the person is kept
+ */
+inline bool isSampled(int aPersonId, double aSampleSize, uint64_t aSeed) {
+	uint64_t hash = splitmix64(aSeed ^ splitmix64((uint32_t)aPersonId));
+	return (hash >> 11) * (1.0 / 9007199254740992.0) < aSampleSize;
+}
+
+
+//! Return the seed of the population sampling.
+/*!
+  \param aProps the model properties
+
+  \return sample.seed, or random.seed if not given, or 0 if neither is a number
+ */
+uint64_t getSampleSeed(const repast::Properties& aProps);
+
+
+//! Return the peak resident memory of the process.
+/*!
+  \return the peak resident set size in kilobytes
+ */
+long getPeakMemory();
+
+
 //! Decompose a string according to a separator into a vector of type T.
 /*!
  \param msg the string to decompose
@@ -0,0 +1,106 @@
+/****************************************************************
+ * ENSEMBLE.HPP
+ *
+ * This file contains the ensemble output related classes.
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file Ensemble.hpp
+ *  \brief Counts of individuals per infection state in every replica of an ensemble.
+ */
+
+#ifndef ENSEMBLE_HPP_
+#define ENSEMBLE_HPP_
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <boost/mpi/communicator.hpp>
+
+#include "Individual.hpp"
+
+//! \brief Counts of individuals per infection state in every replica of an ensemble.
+/*!
+  The replicas of an ensemble (see ensemble.replicas) share the agents and
+  their mobility, only the disease state being per replica. The counts of
+  the process are summed over the processes and written by the process 0,
+  one row per replica.
+ */
+class EnsembleCounts {
+
+private:
+
+	int                     _n_replicas;   //!< number of replicas
+	std::vector<int>        _counts;       //!< counts of the process, 5 states per replica (the susceptible ones set by write)
+	int                     _n_individuals; //!< number of individuals counted by the process
+	int                     _interval;     //!< number of ticks between two outputs
+	int                     _proc;         //!< rank of the process
+	std::ofstream           _out;          //!< output file (process 0 only)
+
+public:
+
+	//! Constructor.
+	/*!
+	  \param aFilename the output file (written by the process 0)
+	  \param aNReplicas the number of replicas
+	  \param aInterval the number of ticks between two outputs
+	  \param aProc the rank of the process
+
+	  Throws a std::runtime_error if the output file cannot be created.
+	 */
+	EnsembleCounts(const std::string& aFilename, int aNReplicas, int aInterval, int aProc);
+
+	//! Return the number of ticks between two outputs.
+	int getInterval() const {
+		return _interval;
+	}
+
+	//! Count the lanes of a word of packed replicas in a state.
+	/*!
+	  \param aCounts the counts of the first replica of the word
+	  \param aLanes the lanes in the state
+	  \param aState the index of the state in the counts of a replica
+	 */
+	static void addLanes(int* aCounts, uint64_t aLanes, int aState) {
+		for( ; aLanes != 0; aLanes &= aLanes - 1 ) aCounts[5 * __builtin_ctzll(aLanes) + aState]++;
+	}
+
+	//! Count an individual in every replica.
+	/*!
+	  Only the replicas where the individual is not susceptible are counted,
+	  the susceptible ones being the remainder. With packed replicas, only
+	  the lanes set in the latent, infectious and recovered planes are
+	  visited, most lanes being susceptible or recovered.
+	 */
+	void add(const Individual& aInd) {
+		_n_individuals++;
+		const std::vector<ReplicaPlanes>& planes = aInd.getPlanes();
+		if( planes.empty() ) {
+			for( int r = 0; r < _n_replicas; r++ ) {
+				state_inf state = aInd.getState(r);
+				if( state != state_inf::SUSCEPTIBLE ) _counts[5 * r + (int)state - 1]++;
+			}
+			return;
+		}
+		for( unsigned int w = 0; w < planes.size(); w++ ) {
+			int* counts = &_counts[5 * REPLICA_LANES * w];
+			uint64_t lanes = (w + 1) * REPLICA_LANES <= (unsigned int)_n_replicas ? ~(uint64_t)0
+					: ((uint64_t)1 << (_n_replicas % REPLICA_LANES)) - 1;
+			addLanes(counts, planes[w].latent() & lanes, 1);
+			addLanes(counts, planes[w].infectiousSympt() & lanes, 2);
+			addLanes(counts, planes[w].infectiousAsympt() & lanes, 3);
+			addLanes(counts, planes[w].recovered() & lanes, 4);
+		}
+	}
+
+	//! Write the counts of all the processes and reset them (collective).
+	/*!
+	  \param aTick the current tick
+	  \param aComm the communicator of the model
+	 */
+	void write(double aTick, const boost::mpi::communicator& aComm);
+
+};
+
+#endif /* ENSEMBLE_HPP_ */
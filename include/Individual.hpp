@@ -23,13 +23,29 @@
 #include "repast_hpc/AgentId.h"
 #include "repast_hpc/Random.h"
 #include "Activity.hpp"
+#include "Replicas.hpp"
 
 const int MODEL_AGENT_IND_TYPE = 0;     //!< constant for the individual agent type
 
-enum class state_inf : unsigned int { SUSCEPTIBLE = 1, LATENT = 2, INFECTIOUS_SYMPT = 3, INFECTIOUS_ASYMPT = 4, RECOVERED = 5 };
 std::ostream& operator<<(std::ostream& out, const state_inf &state);
 
 
+//! Disease state of an individual in one of the additional replicas of an ensemble (see ensemble.replicas).
+struct ReplicaState {
+
+	state_inf             state;              //!< Individual's sickness status in the replica.
+	int                   time_next_state;    //!< Individual's time before next state transition in the replica.
+
+	//! Serializing procedure of the replica state.
+	template <class Archive>
+	void serialize ( Archive &ar , const unsigned int version ) {
+		ar &state;
+		ar &time_next_state;
+	};
+
+};
+
+
 //! \brief The package structure for Individual agents.
 /*!
   A structure used for passing individual agents from one process to another.
@@ -50,6 +66,8 @@ struct IndividualPackage {
 	char                  edu_level;          //!< Individual's education level.
 	state_inf             state;              //!< Individual's sickness status.
 	int                   time_next_state;    //!< Individual's time before next state transition.
+	std::vector<ReplicaState> replicas;       //!< Individual's disease state in the additional replicas.
+	std::vector<ReplicaPlanes> planes;        //!< Individual's disease state in the packed replicas.
 
 	//! Default constructor.
 	IndividualPackage();
@@ -76,6 +94,8 @@ struct IndividualPackage {
 		ar &edu_level;
 		ar &state;
 		ar &time_next_state;
+		ar &replicas;
+		ar &planes;
 	};
 
 };
@@ -107,6 +127,18 @@ private :
 	char                  _edu_level;          //!< Individual's education level.
 	state_inf             _state;              //!< Individual's sickness status.
 	int                   _time_next_state;    //!< Individual's time before becoming infectious.
+	std::vector<ReplicaState> _replicas;       //!< Individual's disease state in the replicas 1, 2, ... of an ensemble (the replica 0 being _state and _time_next_state)
+	std::vector<ReplicaPlanes> _planes;        //!< Individual's disease state in the replicas of a packed ensemble (_state being the one of the replica 0)
+
+	//! Return the sickness status of a replica.
+	state_inf& stateOf(int aReplica) {
+		return aReplica == 0 ? _state : _replicas[aReplica - 1].state;
+	}
+
+	//! Return the time before next state transition of a replica.
+	int& timeOf(int aReplica) {
+		return aReplica == 0 ? _time_next_state : _replicas[aReplica - 1].time_next_state;
+	}
 
 public :
 
@@ -183,6 +215,58 @@ public :
 		_state = state;
 	}
 
+	//! Return the sickness status in a replica of the ensemble (0 being the one of getState).
+	state_inf getState(int aReplica) const {
+		if( aReplica == 0 ) return _state;
+		if( !_planes.empty() ) return _planes[aReplica / REPLICA_LANES].get(aReplica % REPLICA_LANES);
+		return _replicas[aReplica - 1].state;
+	}
+
+	void setState(int aReplica, state_inf state) {
+		if( !_planes.empty() ) {
+			_planes[aReplica / REPLICA_LANES].set(aReplica % REPLICA_LANES, state);
+			if( aReplica == 0 ) _state = state;
+		} else {
+			stateOf(aReplica) = state;
+		}
+	}
+
+	//! Return the number of replicas of the ensemble.
+	int getNReplicas() const {
+		return _replicas.size() + 1;
+	}
+
+	//! Set the number of replicas of the ensemble, the new replicas starting from the state of the replica 0.
+	void setNReplicas(int aNReplicas);
+
+	const std::vector<ReplicaState>& getReplicas() const {
+		return _replicas;
+	}
+
+	void setReplicas(const std::vector<ReplicaState>& replicas) {
+		_replicas = replicas;
+	}
+
+	//! Pack the disease state of a number of replicas in bit-planes, all the replicas starting from the current state.
+	void setPackedReplicas(int aNReplicas);
+
+	const std::vector<ReplicaPlanes>& getPlanes() const {
+		return _planes;
+	}
+
+	std::vector<ReplicaPlanes>& getPlanes() {
+		return _planes;
+	}
+
+	void setPlanes(const std::vector<ReplicaPlanes>& planes) {
+		_planes = planes;
+	}
+
+	//! Set the sickness status to the one of the replica 0 of the planes, after they changed.
+	void syncState() {
+		_state = _planes[0].get(0);
+	}
+
 	char getSocioProStatus() const {
 		return _socio_pro_status;
 	}
@@ -199,6 +283,14 @@ public :
 		_time_next_state = aTime;
 	}
 
+	int getTimeTransition(int aReplica) const {
+		return aReplica == 0 ? _time_next_state : _replicas[aReplica - 1].time_next_state;
+	}
+
+	void setTimeTransition(int aReplica, int aTime) {
+		timeOf(aReplica) = aTime;
+	}
+
 	long getHouseNodeId() const;
 
 	long getCurActNodeId() const;
@@ -217,11 +309,12 @@ public :
 	//! Overloading << operator.
 	friend std::ostream& operator<<(std::ostream& out, const Individual &ind);
 
-	bool isLatent( float aInfectionProba );
+	// the disease state transitions, in the replica 0 unless otherwise specified
+	bool isLatent( float aInfectionProba, int aReplica = 0 );
 
-	void decreaseTimeTransition();
+	void decreaseTimeTransition( int aReplica = 0 );
 
-	void determineInfectiousType( float aInfectionTypeProba );
+	void determineInfectiousType( float aInfectionTypeProba, int aReplica = 0 );
 
 	bool resetSchedule( int aTime );
 
@@ -0,0 +1,133 @@
+/****************************************************************
+ * INPUTSTREAM.HPP
+ *
+ * This file contains the input files reading related classes
+ * and methods.
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file InputStream.hpp
+ *  \brief Pipelined reading of plain, gzip or zstd compressed input files.
+ */
+
+#ifndef INPUTSTREAM_HPP_
+#define INPUTSTREAM_HPP_
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace xmlpp {
+	class SaxParser;
+}
+
+//! Compression of an input file.
+enum Compression {
+	COMPRESSION_NONE,   //!< plain file
+	COMPRESSION_GZIP,   //!< gzip (possibly multi-member, as produced by pigz or bgzip)
+	COMPRESSION_ZSTD    //!< zstd (requires building with USE_ZSTD=1)
+};
+
+
+//! \brief Chunked reader of a possibly compressed file.
+/*!
+  The file is read, and decompressed if needed, by a background thread
+  filling a bounded pool of buffers, so that decompression overlaps with
+  the parsing done by the caller. The compression is detected from the
+  magic bytes of the file, not from its name.
+ */
+class InputStream {
+
+private:
+
+	std::string                     _filename;       //!< name of the file
+	Compression                     _compression;    //!< compression of the file
+	FILE*                           _file;           //!< the file
+	std::vector<std::vector<char> > _buffers;        //!< buffers pool
+	std::vector<size_t>             _sizes;          //!< number of bytes held by each buffer
+	std::deque<int>                 _free;           //!< buffers ready to be filled
+	std::deque<int>                 _full;           //!< buffers ready to be read, in file order
+	int                             _current;        //!< buffer currently read by the caller (-1 if none)
+	bool                            _eof;            //!< true once the producer has read the whole file
+	bool                            _stop;           //!< true to request the producer to stop
+	std::string                     _error;          //!< error raised by the producer, if any
+	std::mutex                      _mutex;          //!< protects the queues and flags
+	std::condition_variable         _cond_free;      //!< signaled when a buffer is released
+	std::condition_variable         _cond_full;      //!< signaled when a buffer is filled or the producer ends
+	std::thread                     _producer;       //!< reading/decompression thread
+
+	InputStream(const InputStream&);
+	InputStream& operator=(const InputStream&);
+
+	//! Body of the producer thread.
+	void produce();
+
+	//! Copy the file to the buffers.
+	void readPlain();
+
+	//! Decompress a gzip file to the buffers.
+	void readGzip();
+
+	//! Decompress a zstd file to the buffers.
+	void readZstd();
+
+	//! Wait for a free buffer.
+	/*!
+	  \return the index of the buffer, or -1 if the stream is being closed
+	 */
+	int acquireFree();
+
+	//! Hand a filled buffer over to the caller.
+	void releaseFull(int aBuffer, size_t aSize);
+
+public:
+
+	//! Constructor, opens the file and starts the producer thread.
+	/*!
+	  \param aFilename the file to read
+	  \param aBufferSize the size of each buffer
+	  \param aNBuffers the number of buffers, i.e. how far the producer can run ahead
+
+	  Throws a std::runtime_error if the file cannot be opened.
+	 */
+	explicit InputStream(const std::string& aFilename, size_t aBufferSize = 1 << 20, int aNBuffers = 4);
+
+	//! Destructor, stops the producer thread and closes the file.
+	~InputStream();
+
+	//! Return the next chunk of (decompressed) data.
+	/*!
+	  \param aData the start of the chunk, valid until the next call
+
+	  \return the size of the chunk, 0 at the end of the file
+
+	  Throws a std::runtime_error if the file cannot be read or decompressed.
+	 */
+	size_t read(const char*& aData);
+
+	//! Return the compression of the file.
+	Compression getCompression() const {
+		return _compression;
+	}
+
+	//! Detect the compression of a file from its magic bytes.
+	static Compression detectCompression(const std::string& aFilename);
+
+};
+
+
+//! Parse a whole, possibly compressed, xml file with a libxml++ SAX parser.
+/*!
+  \param aFilename the xml file
+  \param aParser the parser
+
+  Throws a xmlpp::exception on parsing errors and a std::runtime_error on reading errors.
+ */
+void parseXmlFile(const std::string& aFilename, xmlpp::SaxParser& aParser);
+
+#endif /* INPUTSTREAM_HPP_ */
@@ -18,7 +18,17 @@
 #include "Individual.hpp"
 #include "Data.hpp"
 #include "SaxParser.hpp"
+#include "AgendaScanner.hpp"
+#include "InputStream.hpp"
 #include "Network.hpp"
+#include "Population.hpp"
+#include "Profiler.hpp"
+#include "Trace.hpp"
+#include "NodeSeries.hpp"
+#include "TransmissionLog.hpp"
+#include "Strata.hpp"
+#include "Checkpoint.hpp"
+#include "Ensemble.hpp"
 
 #include "repast_hpc/SharedContext.h"
 #include "repast_hpc/Schedule.h"
@@ -50,6 +60,7 @@
 #include <boost/unordered_set.hpp>
 #include <boost/math/special_functions/pow.hpp>
 #include <boost/range/algorithm.hpp>
+#include <boost/filesystem.hpp>
 
 //! Model class.
 /*!
@@ -61,6 +72,7 @@ class Model {
  private :
 
   friend class ProviderReceiver;
+  friend class KernelBench;
 
   int                            _proc;                         //!< rank of the model's process
   repast::Properties&            _props;                        //!< properties of the model
@@ -77,6 +89,26 @@ class Model {
   AggregateSum _total_recovered;
   AggregateSum _total_nodes_infected;
 
+  // Per node outputs
+
+  NodeSeriesWriter*              _node_series;                  //!< per node infectious and latent counts (NULL if disabled)
+  int                            _node_series_interval;         //!< number of ticks between two frames of the per node output
+  int                            _first_node;                   //!< first node of the process
+  std::vector<int32_t>           _node_values;                  //!< per node counts of the current frame
+  TransmissionLog*               _transmissions;                //!< who infected whom on the process (NULL if disabled)
+  StrataCounts*                  _strata;                       //!< counts per state and stratum (NULL if disabled)
+
+  // Ensemble
+
+  int                            _n_replicas;                   //!< number of replicas of the ensemble (1: no ensemble)
+  bool                           _packed;                       //!< true if the replicas are packed in bit-planes (see ReplicaPlanes)
+  std::vector<uint64_t>          _lanes;                        //!< replicas of the ensemble, one bit per replica (64 per word, as the lanes of the bit-planes)
+  std::vector<uint64_t>          _active_replicas;              //!< replicas not extinct yet, one bit per replica
+  std::vector<uint64_t>          _local_active;                 //!< replicas with latent or infectious agents on the process, one bit per replica
+  int                            _extinction_interval;          //!< number of ticks between two extinction checks (0: no check)
+  long                           _n_active_local;               //!< upper bound of the latent or infectious agents on the process (0: the disease steps are skipped)
+  EnsembleCounts*                _ensemble;                     //!< counts of every replica (NULL if no ensemble)
+
   // Model parameters
 
   float _r_beta;
@@ -87,12 +119,34 @@ class Model {
   float _max_inf;
   float _r_beta_x_beta;
 
+  LaneBernoulli _draw_latent_end;                               //!< per tick end of the latent state of the packed replicas
+  LaneBernoulli _draw_recovery;                                 //!< per tick recovery of the packed replicas
+  LaneBernoulli _draw_asympt;                                   //!< asymptomatic infection type of the packed replicas
+  LaneBernoulli _draw_infect_sympt;                             //!< infection by a symptomatic agent of the packed replicas
+  LaneBernoulli _draw_infect_asympt;                            //!< infection by an asymptomatic agent of the packed replicas
+
   int _time_step;
+  int _time_of_day;                                             //!< current time of the day in seconds
+  int _days_simulated;                                          //!< number of days simulated so far
   float _sample_size;
+  uint64_t _sample_seed;                                        //!< seed of the population sampling (see isSampled)
   
+  // Checkpoints
+
+  int                            _start_tick;                   //!< tick the simulation starts from (0, or the tick of the checkpoint restarted from)
+  int                            _checkpoint_interval;          //!< number of ticks between two checkpoints (0: no checkpoint)
+  std::string                    _checkpoint_dir;               //!< directory of the checkpoints
+
+  // Scenarios
+
+  CheckpointPart                 _snapshot;                     //!< agents of the process before the first scenario (see startScenario)
+  int                            _snapshot_time_of_day;         //!< time of the day of the snapshot
+  int                            _snapshot_days_simulated;      //!< number of days simulated of the snapshot
+
   // Synch variables
 
-  std::map<int, int>             _map_node_process;             //!< map containing identifying the process of every node
+  int                            _n_nodes_network;              //!< number of nodes of the network (see getNodeProcess)
+  int                            _n_proc;                       //!< number of processes
   std::map<repast::AgentId, int> _map_agents_to_move_process;   //!< map of the agents to be moved to other processes
 
   // Contexts and projections
@@ -112,9 +166,98 @@ class Model {
   //! Destructor.
   ~Model();
 
-  //! Model agents initialization (MATSim input format).
+  //! Model agents initialization (MATSim input format or binary population file).
   void init_agents_sax();
 
+  //! Model agents initialization from a binary population file (see Population.hpp).
+  /*!
+    \param aFilename the population file
+   */
+  void init_agents_bin(const std::string& aFilename);
+
+  //! Model agents initialization from the shard of the current process of a population file.
+  /*!
+    \param aFilename the population file
+    \param aCollective true to read the shards with collective MPI-IO, false to have them read and sent by the process 0
+
+    \return false if the file does not have one shard per process
+   */
+  bool init_agents_shard(const std::string& aFilename, bool aCollective);
+
+  //! Check that a population file can be used with the model properties.
+  void checkPopulation(const PopulationHeader& aHeader, const std::string& aFilename) const;
+
+  //! Add a person of a population file to the model if it belongs to the sample.
+  /*!
+    \param aPerson the person
+    \param aActivities its agenda (aPerson.n_activities records)
+   */
+  void addPopulationAgent(const PersonRecord& aPerson, const ActivityRecord* aActivities);
+
+  //! Read the model parameters and initialize the random generators.
+  void initParameters();
+
+  //! Create the outputs of the simulation (collective).
+  /*!
+    \param aOutputDir the directory of the outputs, created if needed (ending with '/')
+   */
+  void initOutputs(const std::string& aOutputDir);
+
+  //! Close the outputs of the simulation.
+  void closeOutputs();
+
+  //! Take the snapshot the scenarios start from (see startScenario).
+  void takeSnapshot();
+
+  //! Remove the local agents of the process.
+  void removeLocalAgents();
+
+  //! Replace the agents and the infected nodes of the process by the ones of the snapshot.
+  void restoreSnapshot();
+
+  //! Prepare a scenario (collective).
+  /*!
+    The model parameters are read again from the properties, the agents
+    restored from the snapshot and infected, and the outputs written to
+    ../output/<aName>/.
+
+    \param aName the name of the scenario
+   */
+  void startScenario(const std::string& aName);
+
+  //! End a scenario, closing its outputs.
+  void endScenario();
+
+  //! Fill the checkpoint part of the process with the current state of the simulation.
+  /*!
+    \param aPart the part
+   */
+  void fillCheckpointPart(CheckpointPart& aPart);
+
+  //! Write a checkpoint of the simulation (collective).
+  /*!
+    \param aTick the current tick
+   */
+  void writeCheckpoint(int aTick);
+
+  //! Restore the state of the simulation from a checkpoint (collective).
+  /*!
+    The agents are read from the part of the same process if the checkpoint
+    was written with the same number of processes, otherwise every process
+    reads all the parts and keeps the agents located on its nodes.
+
+    \param aDir the directory of the checkpoint
+   */
+  void restoreCheckpoint(const std::string& aDir);
+
+  //! Add the agents of a checkpoint part to the process and set the infected count of its nodes.
+  /*!
+    \param aPart the part
+    \param aSameProc true if the part was written by the process, false to only add the agents located on its nodes
+    \param aNodes the nodes of the process
+   */
+  void restoreCheckpointPart(CheckpointPart& aPart, bool aSameProc, std::map<int, Node>& aNodes);
+
   //! Model agents localization initialization.
   void synch_agents();
 
@@ -124,6 +267,34 @@ class Model {
   //! Implements one step of the simulation.
   void step();
 
+  //! Disease progression of an agent in the packed replicas.
+  /*!
+    \param aInd the agent
+
+    \return true if the agent is infectious in any replica
+   */
+  bool progressPacked(Individual& aInd);
+
+  //! Infection of the agents on a node by an infectious agent in the packed replicas.
+  /*!
+    \param aInfector the infectious agent
+    \param aAgents the agents on the node of the infectious agent
+    \param aNodeId the node
+    \param aTick the current tick
+
+    \return the number of agents infected in any replica
+   */
+  int infectPacked(Individual& aInfector, const std::vector<Individual*>& aAgents, int aNodeId, int aTick);
+
+  //! Check if an agent is latent or infectious in any replica.
+  bool isActive(const Individual& aInd) const;
+
+  //! Drop the replicas without latent nor infectious agents, stopping the simulation if none is left (collective).
+  /*!
+    \param aTick the current tick
+   */
+  void checkExtinction(int aTick);
+
   //! Used by Repast HPC to exchange Individual agents between process.
   /*!
     \param agent the agent to exchange
@@ -157,9 +328,6 @@ class Model {
   	return _props;
   }
 
-  //! Constructing the map of processes' nodes.
-  void constructMapNodeProcess();
-
   //! Check if a node belongs to the current process.
   /*!
     \param nodeId the node to check
@@ -168,11 +336,13 @@ class Model {
    */
   bool isInLocalBounds(int nodeId);
 
-  //! Return the map associating the nodes id to their respective process.
+  //! Return the process of a node, computed from the nodes partition (see Data::getNodesRange).
   /*!
-    \return a map
+    \param aNodeId the internal id of the node
+
+    \return the rank of the process, a std::out_of_range being thrown for a node out of the network
    */
-  const std::map<int, int>& getMapNodeProcess() const;
+  int getNodeProcess(int aNodeId) const;
 
   //! Infect the agents.
   void initInfectAgents();
@@ -194,6 +364,11 @@ class Model {
   //! Return the sample size
   float getSampleSize() const;
 
+  //! Return the seed of the population sampling
+  uint64_t getSampleSeed() const {
+    return _sample_seed;
+  }
+
   //! Save the data from an agent to the aggregate dataset
   /*!
     \param aInd the individual agent
@@ -203,6 +378,12 @@ class Model {
   //! Reset the counters of the aggregate dataset to 0
   void resetDataInd();
 
+  //! Write a frame of the per node output (infectious and latent agents on each node of the process).
+  /*!
+    \param aTick the current tick
+   */
+  void recordNodeSeries(double aTick);
+
 };
 
 #endif /* MODEL_HPP_ */
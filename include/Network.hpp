@@ -126,7 +126,8 @@ public:
 	  _n_infected_nodes = infectedNodes;
   }
 
-  void dumpNodes(int aId);
+  //! Dump the ids of the nodes to the file dump_nodes<aSuffix>.
+  void dumpNodes(const std::string& aSuffix);
 
 };
 
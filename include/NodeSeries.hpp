@@ -0,0 +1,115 @@
+/****************************************************************
+ * NODESERIES.HPP
+ *
+ * This file contains the per node output related classes.
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file NodeSeries.hpp
+ *  \brief Per node time series written in parallel with MPI-IO.
+ *
+ *  A node series file holds, every given number of ticks, a frame made of
+ *  n_columns columns of n_nodes int32 values indexed by the internal node
+ *  id. Its layout is
+ *  - a NodeSeriesHeader;
+ *  - the frames, frame f starting at frames_offset + f * n_columns * n_nodes * 4
+ *    and column c of a frame at c * n_nodes * 4 from the frame start.
+ *
+ *  Every process writes the values of its own nodes (see Data::getNodesRange)
+ *  with one collective write per frame, nothing is gathered on a process.
+ *  The process 0 also writes a csv index (frame;tick;offset) next to the file,
+ *  the number of frames being given by the file size as well.
+ */
+
+#ifndef NODESERIES_HPP_
+#define NODESERIES_HPP_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <mpi.h>
+
+const char     NODE_SERIES_MAGIC[8] = { 'V', 'B', 'N', 'O', 'D', 'E', 0, 0 }; //!< magic number of a node series file
+const uint32_t NODE_SERIES_VERSION  = 1;                                      //!< current version of the format
+
+//! Header of a node series file.
+struct NodeSeriesHeader {
+	char     magic[8];            //!< NODE_SERIES_MAGIC
+	uint32_t version;             //!< NODE_SERIES_VERSION
+	uint32_t n_columns;           //!< number of columns of a frame
+	uint64_t n_nodes;             //!< number of nodes of the network
+	uint64_t interval;            //!< number of ticks between two frames
+	uint64_t frames_offset;       //!< offset of the first frame
+	char     columns[64];         //!< names of the columns, separated by ';'
+};
+
+static_assert(sizeof(NodeSeriesHeader) == 104, "unexpected NodeSeriesHeader layout");
+
+
+//! \brief Parallel writer of a node series file.
+/*!
+  The file view of a process selects its nodes range in every column, so a
+  frame is written with a single collective MPI_File_write_at_all of the
+  local values, column after column.
+ */
+class NodeSeriesWriter {
+
+private:
+
+	std::string    _filename;     //!< output file name
+	MPI_Comm       _comm;         //!< communicator of the simulation
+	int            _rank;         //!< rank of the process
+	MPI_File       _file;         //!< the file (MPI_FILE_NULL once closed)
+	MPI_Datatype   _view;         //!< nodes range of the process in the columns of a frame
+	uint32_t       _n_columns;    //!< number of columns of a frame
+	uint64_t       _n_nodes;      //!< number of nodes of the network
+	uint64_t       _n_local;      //!< number of nodes of the process
+	uint64_t       _n_frames;     //!< number of frames written so far
+	std::ofstream  _index;        //!< csv index (process 0 only)
+
+	NodeSeriesWriter(const NodeSeriesWriter&);
+	NodeSeriesWriter& operator=(const NodeSeriesWriter&);
+
+public:
+
+	//! Constructor, creates the file (collective).
+	/*!
+	  \param aFilename the output file, the index being written to aFilename.idx
+	  \param aComm the communicator of the simulation
+	  \param aColumns the names of the columns
+	  \param aNNodes the number of nodes of the network
+	  \param aFirstNode the first node of the process
+	  \param aLastNode the last node of the process
+	  \param aInterval the number of ticks between two frames, recorded in the header
+
+	  Throws a std::runtime_error if the file cannot be created.
+	 */
+	NodeSeriesWriter(const std::string& aFilename, MPI_Comm aComm, const std::vector<std::string>& aColumns,
+			uint64_t aNNodes, int aFirstNode, int aLastNode, uint64_t aInterval);
+
+	//! Destructor, closes the file.
+	~NodeSeriesWriter();
+
+	//! Write a frame (collective).
+	/*!
+	  \param aTick the tick of the frame
+	  \param aValues the values of the nodes of the process, column after column
+	         (n_columns * (aLastNode - aFirstNode + 1) values)
+
+	  Throws a std::runtime_error if the frame cannot be written.
+	 */
+	void writeFrame(double aTick, const std::vector<int32_t>& aValues);
+
+	//! Close the file (collective).
+	void close();
+
+	//! Return the number of frames written so far.
+	uint64_t getNFrames() const {
+		return _n_frames;
+	}
+
+};
+
+#endif /* NODESERIES_HPP_ */
@@ -0,0 +1,290 @@
+/****************************************************************
+ * POPULATION.HPP
+ *
+ * This file contains the binary population format related
+ * classes and methods.
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file Population.hpp
+ *  \brief Preprocessed binary population format declarations.
+ *
+ *  A population file holds the activity chains of the MATSim agenda
+ *  with node ids already mapped to the internal ids of the network.
+ *  Its layout is
+ *  - a PopulationHeader;
+ *  - n_shards ShardRecord;
+ *  - n_persons fixed-width PersonRecord, grouped by shard and in the
+ *    order of the xml file within a shard;
+ *  - n_activities ActivityRecord (the agenda arena), every person
+ *    owning a contiguous slice, in the order of the persons;
+ *  - n_nodes + 1 offsets into the home index;
+ *  - the home index, i.e. the persons indices grouped by home node.
+ *
+ *  A shard holds the persons whose home node is handled by a given process
+ *  when the simulation runs on n_shards processes (see Data::getNodesRange),
+ *  so its persons and activities are two contiguous ranges of the file.
+ */
+
+#ifndef POPULATION_HPP_
+#define POPULATION_HPP_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <mpi.h>
+
+#include "Data.hpp"
+
+const char     POPULATION_MAGIC[8]  = { 'V', 'B', 'P', 'O', 'P', 0, 0, 0 }; //!< magic number of a population file
+const uint32_t POPULATION_VERSION   = 3;                                     //!< current version of the format
+const uint32_t POPULATION_BYTE_ORDER = 0x01020304;                           //!< used to detect an endianness mismatch
+
+//! Header of a binary population file.
+struct PopulationHeader {
+	char     magic[8];            //!< POPULATION_MAGIC
+	uint32_t version;             //!< POPULATION_VERSION
+	uint32_t byte_order;          //!< POPULATION_BYTE_ORDER as written by the converter
+	uint64_t n_persons;           //!< number of person records
+	uint64_t n_activities;        //!< number of activity records
+	uint64_t n_nodes;             //!< number of nodes of the network used for the node ids mapping
+	uint64_t n_indexed;           //!< number of persons in the home index
+	uint64_t persons_offset;      //!< offset of the person records
+	uint64_t activities_offset;   //!< offset of the activity records
+	uint64_t node_index_offset;   //!< offset of the n_nodes + 1 home index offsets
+	uint64_t home_index_offset;   //!< offset of the home index
+	double   sample_size;         //!< sample size applied by the converter (1 if not sampled)
+	uint64_t sample_seed;         //!< seed of the sampling applied by the converter (see isSampled)
+	uint64_t n_shards;            //!< number of shards (1 if not sharded)
+	uint64_t shard_table_offset;  //!< offset of the shard records
+};
+
+//! Persons and activities ranges of a shard.
+struct ShardRecord {
+	uint64_t first_person;        //!< index of the first person of the shard
+	uint64_t n_persons;           //!< number of persons of the shard
+	uint64_t first_activity;      //!< index of the first activity of the shard
+	uint64_t n_activities;        //!< number of activities of the shard
+};
+
+//! Fixed-width person record.
+struct PersonRecord {
+	int32_t  id;                  //!< id of the individual
+	int32_t  age_cl;              //!< age class
+	int32_t  home_node;           //!< internal id of the node of the first activity (-1 if none)
+	uint32_t n_activities;        //!< number of activities in the agenda
+	uint64_t first_activity;      //!< index of the first activity in the agenda arena
+	char     gender;              //!< gender
+	char     socio_pro_status;    //!< socio-professional status
+	char     edu_level;           //!< education level
+	char     padding[5];
+};
+
+//! Fixed-width activity record (mirrors the Activity class).
+struct ActivityRecord {
+	int32_t node_id;              //!< internal id of the node
+	int32_t start_time;           //!< starting time in seconds since midnight (-1 if none)
+	int32_t end_time;             //!< ending time in seconds since midnight (-1 if none)
+	char    type;                 //!< type of the activity
+	char    padding[3];
+};
+
+static_assert(sizeof(PopulationHeader) == 112, "unexpected PopulationHeader layout");
+static_assert(sizeof(ShardRecord)      == 32, "unexpected ShardRecord layout");
+static_assert(sizeof(PersonRecord)     == 32, "unexpected PersonRecord layout");
+static_assert(sizeof(ActivityRecord)   == 16, "unexpected ActivityRecord layout");
+
+
+//! \brief Writer of binary population files.
+/*!
+  The person records and the activities are spooled to temporary files and
+  reordered by shard when the file is finished, so the memory footprint only
+  depends on the number of persons (8 bytes each) and not on the agendas.
+ */
+class PopulationWriter {
+
+private:
+
+	std::string           _filename;          //!< output file name
+	std::string           _tmp_filename;      //!< activities spool file name
+	std::string           _persons_filename;  //!< persons spool file name
+	FILE*                 _out;               //!< output file
+	FILE*                 _tmp;               //!< activities spool file
+	FILE*                 _persons;           //!< persons spool file
+	uint64_t              _n_nodes;           //!< number of nodes of the network
+	uint64_t              _n_activities;      //!< number of activities written so far
+	double                _sample_size;       //!< sample size applied to the persons
+	uint64_t              _sample_seed;       //!< seed of the sampling
+	uint64_t              _n_shards;          //!< number of shards
+	std::vector<int32_t>  _home_nodes;        //!< home node of every person written so far
+
+public:
+
+	//! Constructor.
+	/*!
+	  \param aFilename the output file
+	  \param aNNodes the number of nodes of the network used for the node ids mapping
+	  \param aSampleSize the sample size applied by the caller to the persons, recorded in the header
+	  \param aSampleSeed the seed of the sampling
+	  \param aNShards the number of processes the persons are grouped for
+	 */
+	PopulationWriter(const std::string& aFilename, uint64_t aNNodes, double aSampleSize = 1.0, uint64_t aSampleSeed = 0,
+			uint64_t aNShards = 1);
+
+	//! Destructor.
+	~PopulationWriter();
+
+	//! Append a person and its agenda.
+	/*!
+	  \param aPerson the person record (home_node, n_activities and first_activity are set by the writer)
+	  \param aActivities the agenda of the person
+	 */
+	void addPerson(PersonRecord aPerson, const std::vector<ActivityRecord>& aActivities);
+
+	//! Write the shards, the agenda arena and the home index, then close the file.
+	void finish();
+
+	//! Return the number of persons written so far.
+	uint64_t getNPersons() const {
+		return _home_nodes.size();
+	}
+
+};
+
+
+//! \brief Read-only memory mapped binary population file.
+class PopulationFile {
+
+private:
+
+	std::string              _filename;     //!< name of the file, for the error messages
+	MappedFile               _file;         //!< mapping of the file
+	const PopulationHeader*  _header;       //!< header of the file
+	const PersonRecord*      _persons;      //!< person records
+	const ActivityRecord*    _activities;   //!< agenda arena
+	const uint64_t*          _node_index;   //!< home index offsets
+	const uint32_t*          _home_index;   //!< persons indices grouped by home node
+
+public:
+
+	//! Constructor, maps the file and checks its header.
+	/*!
+	  \param aFilename the population file
+
+	  Throws a std::runtime_error if the file cannot be mapped or is not a valid population file.
+	 */
+	explicit PopulationFile(const std::string& aFilename);
+
+	//! Destructor.
+	~PopulationFile() {}
+
+	//! Check if a file starts with the population file magic number.
+	static bool isPopulationFile(const std::string& aFilename);
+
+	//! Check the header of a population file.
+	/*!
+	  \param aHeader the header
+	  \param aFileSize the size of the file
+	  \param aFilename the name of the file, for the error messages
+
+	  Throws a std::runtime_error if the header is not valid.
+	 */
+	static void checkHeader(const PopulationHeader& aHeader, uint64_t aFileSize, const std::string& aFilename);
+
+	const PopulationHeader& getHeader() const {
+		return *_header;
+	}
+
+	uint64_t getNPersons() const {
+		return _header->n_persons;
+	}
+
+	uint64_t getNNodes() const {
+		return _header->n_nodes;
+	}
+
+	//! Return a person, throwing a std::runtime_error if the index is out of the file.
+	const PersonRecord& getPerson(uint64_t aIndex) const {
+		if( aIndex >= _header->n_persons ) invalid();
+		return _persons[aIndex];
+	}
+
+	uint64_t getNShards() const {
+		return _header->n_shards;
+	}
+
+	//! Return the first activity of a person (the agenda spans person.n_activities records).
+	/*!
+	  Throws a std::runtime_error if the agenda is out of the activities of the file.
+	 */
+	const ActivityRecord* getActivities(const PersonRecord& aPerson) const {
+		if( aPerson.first_activity > _header->n_activities
+				|| aPerson.n_activities > _header->n_activities - aPerson.first_activity ) {
+			invalid();
+		}
+		return _activities + aPerson.first_activity;
+	}
+
+	//! Return the indices of the persons living on a node as a [begin, end[ range.
+	/*!
+	  Throws a std::runtime_error if the range is out of the home index of the file.
+	 */
+	void getPersonsAtNode(int aNodeId, const uint32_t*& aBegin, const uint32_t*& aEnd) const {
+		if( aNodeId < 0 || (uint64_t)aNodeId >= _header->n_nodes ) invalid();
+		uint64_t begin = _node_index[aNodeId];
+		uint64_t end   = _node_index[aNodeId + 1];
+		if( begin > end || end > _header->n_indexed ) invalid();
+		aBegin = _home_index + begin;
+		aEnd   = _home_index + end;
+	}
+
+private:
+
+	//! Throw a std::runtime_error reporting an invalid population file.
+	void invalid() const;
+
+	PopulationFile(const PopulationFile&);
+	PopulationFile& operator=(const PopulationFile&);
+
+};
+
+
+//! Persons of a sharded population file owned by the current process.
+struct PopulationShard {
+	PopulationHeader            header;       //!< header of the file
+	std::vector<PersonRecord>   persons;      //!< person records, first_activity is relative to activities
+	std::vector<ActivityRecord> activities;   //!< activities of the persons
+};
+
+
+//! Read the shard of the current process with collective MPI-IO.
+/*!
+  \param aFilename the population file
+  \param aComm the communicator of the simulation
+  \param aShard the shard read
+
+  \return false if the file does not have one shard per process
+
+  Throws a std::runtime_error if the file cannot be read or is not valid.
+ */
+bool readPopulationShard(const std::string& aFilename, MPI_Comm aComm, PopulationShard& aShard);
+
+
+//! Read the shards on the process 0 and send them to their process.
+/*!
+  Only the process 0 opens the file, the shards are read and sent one
+  after the other.
+
+  \param aFilename the population file
+  \param aComm the communicator of the simulation
+  \param aShard the shard received
+
+  \return false if the file does not have one shard per process
+
+  Throws a std::runtime_error if the file cannot be read or is not valid.
+ */
+bool scatterPopulationShards(const std::string& aFilename, MPI_Comm aComm, PopulationShard& aShard);
+
+#endif /* POPULATION_HPP_ */
@@ -0,0 +1,247 @@
+/****************************************************************
+ * PROFILER.HPP
+ *
+ * This file contains the startup and step profiling related
+ * classes.
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file Profiler.hpp
+ *  \brief Wall time and peak memory of the startup phases of a process, and
+ *  time of the phases of the simulation steps.
+ */
+
+#ifndef PROFILER_HPP_
+#define PROFILER_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+//! \brief Wall time and peak resident memory of the startup phases of a process.
+/*!
+  A phase is timed between start() and stop(); a phase started several times
+  accumulates its time. The time spent in a phase nested in the current one
+  (e.g. the agents insertion during the agenda parsing) is reported with
+  addNested() and is not counted in the current phase.
+ */
+class StartupProfiler {
+
+private:
+
+	typedef std::chrono::steady_clock Clock;
+
+	//! A startup phase.
+	struct Phase {
+		std::string name;          //!< name of the phase
+		double      time;          //!< wall time in seconds
+		long        peak_memory;   //!< peak resident memory at the end of the phase in kB
+	};
+
+	std::vector<Phase> _phases;    //!< phases, in the order they were first started
+	int                _current;   //!< index of the current phase (-1 if none)
+	Clock::time_point  _start;     //!< start of the current phase
+	double             _nested;    //!< time of the phases nested in the current one
+
+	StartupProfiler() : _phases(), _current(-1), _start(), _nested(0.0) {}
+
+	//! Return the index of a phase, adding it if needed.
+	int getPhase(const std::string& aName);
+
+public:
+
+	//! Return the profiler of the process.
+	static StartupProfiler& instance();
+
+	//! Start a phase, stopping the current one if any.
+	void start(const std::string& aName);
+
+	//! Stop the current phase.
+	void stop();
+
+	//! Add the time of a phase nested in the current one.
+	/*!
+	  \param aName name of the nested phase
+	  \param aStart when the nested phase started
+	 */
+	void addNested(const std::string& aName, Clock::time_point aStart);
+
+	//! Return the current time, to be given to addNested.
+	static Clock::time_point now() {
+		return Clock::now();
+	}
+
+	//! Write the phases to a csv file (phase;time;peak_memory).
+	void write(const std::string& aFilename) const;
+
+};
+
+
+//! Phases of a simulation step (see Model::step).
+enum StepPhase {
+	PHASE_PROGRESSION,   //!< disease progression of an agent
+	PHASE_LOCATION,      //!< location lookup of an agent
+	PHASE_QUERY,         //!< query of the agents on the node of an infectious agent
+	PHASE_INFECTION,     //!< infection draws on the agents of the node
+	PHASE_ACTIVITY,      //!< activity transition and move of an agent
+	PHASE_GATHER,        //!< aggregate data gathering of an agent
+	PHASE_RECORD,        //!< aggregate data recording
+	PHASE_BALANCE,       //!< agents moves between processes (balance)
+	PHASE_SYNC,          //!< agents status synchronization (synchronizeAgentStatus)
+	N_STEP_PHASES
+};
+
+
+//! \brief Time spent in the phases of the simulation steps of a process.
+/*!
+  The phases are timed with the time stamp counter, each one accumulating
+  its total time, number of calls and a histogram of the log2 of its
+  durations in cycles. The phases run per agent (disease progression,
+  location, query, infection, activity and data gathering) are only timed
+  for one agent out of a sampling period, and counted as many times in the
+  calls and the histogram.
+
+  The profiler is enabled by log.step, and compiled out with
+  -DNO_STEP_TIMERS (make NO_STEP_TIMERS=1).
+ */
+class StepProfiler {
+
+private:
+
+	typedef std::chrono::steady_clock Clock;
+
+	static const int N_BUCKETS = 48;   //!< number of buckets of the histograms
+
+	//! A step phase.
+	struct Phase {
+		uint64_t cycles;                 //!< total time in cycles
+		uint64_t calls;                  //!< number of calls
+		uint64_t histogram[N_BUCKETS];   //!< number of calls per log2 of their duration in cycles
+	};
+
+	bool               _enabled;         //!< true if the phases are timed
+	unsigned int       _sampling;        //!< sampling period of the per agent phases (a power of 2)
+	unsigned int       _counter;         //!< counter of the per agent phases
+	Phase              _phases[N_STEP_PHASES];   //!< phases
+	Phase              _last[N_STEP_PHASES];     //!< phases at the end of the last interval
+	uint64_t           _start_cycles;    //!< time stamp counter when the profiler was enabled
+	Clock::time_point  _start;           //!< time when the profiler was enabled
+	std::ofstream      _intervals;       //!< output of the time per interval (if any)
+
+	StepProfiler();
+
+	//! Return the number of seconds per cycle.
+	double getSecondsPerCycle() const;
+
+public:
+
+	//! Return the profiler of the process.
+	static StepProfiler& instance();
+
+	//! Enable the profiler.
+	/*!
+	  \param aSampling the sampling period of the per agent phases (rounded to a power of 2)
+	  \param aIntervalsFilename the output of the time per interval (see writeInterval), none if empty
+	 */
+	void enable(unsigned int aSampling, const std::string& aIntervalsFilename);
+
+	//! Return true if the phases are timed.
+	bool isEnabled() const {
+#ifdef NO_STEP_TIMERS
+		return false;
+#else
+		return _enabled;
+#endif
+	}
+
+	//! Return true if the per agent phases of the current agent are timed.
+	bool sample() {
+#ifdef NO_STEP_TIMERS
+		return false;
+#else
+		return _enabled && (++_counter & (_sampling - 1)) == 0;
+#endif
+	}
+
+	//! Return the sampling period of the per agent phases.
+	unsigned int getSampling() const {
+		return _sampling;
+	}
+
+	//! Return the time stamp counter.
+	static uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	//! Add a call to a phase.
+	/*!
+	  \param aPhase the phase
+	  \param aCycles the duration of the call in cycles
+	  \param aWeight the number of calls it stands for
+	 */
+	void add(StepPhase aPhase, uint64_t aCycles, unsigned int aWeight) {
+		Phase& phase = _phases[aPhase];
+		phase.cycles += aCycles * aWeight;
+		phase.calls  += aWeight;
+		int bucket = aCycles == 0 ? 0 : 64 - __builtin_clzll(aCycles);
+		phase.histogram[bucket < N_BUCKETS ? bucket : N_BUCKETS - 1] += aWeight;
+	}
+
+	//! Write the time of the phases since the last interval (interval;phase;calls;time).
+	/*!
+	  \param aInterval the interval (e.g. the simulated hour)
+	 */
+	void writeInterval(int aInterval);
+
+	//! Write the phases to a csv file (phase;calls;time;mean_time) and their histograms to <file>_hist.csv (phase;min_cycles;count).
+	void write(const std::string& aFilename) const;
+
+};
+
+
+//! \brief Timer of a step phase, from its construction to its destruction.
+class ScopedPhase {
+
+#ifndef NO_STEP_TIMERS
+private:
+
+	StepPhase    _phase;    //!< phase timed
+	unsigned int _weight;   //!< number of calls the call stands for (0: not timed)
+	uint64_t     _start;    //!< time stamp counter at the start of the call
+
+public:
+
+	//! Constructor.
+	/*!
+	  \param aPhase the phase
+	  \param aTimed true if the call is timed
+	  \param aWeight the number of calls the call stands for
+	 */
+	ScopedPhase(StepPhase aPhase, bool aTimed, unsigned int aWeight = 1) :
+		_phase(aPhase), _weight(aTimed ? aWeight : 0), _start(aTimed ? StepProfiler::cycles() : 0) {
+	}
+
+	//! Destructor, adding the call to the phase.
+	~ScopedPhase() {
+		if( _weight > 0 ) StepProfiler::instance().add(_phase, StepProfiler::cycles() - _start, _weight);
+	}
+#else
+public:
+
+	ScopedPhase(StepPhase aPhase, bool aTimed, unsigned int aWeight = 1) {
+	}
+#endif
+
+};
+
+#endif /* PROFILER_HPP_ */
@@ -0,0 +1,147 @@
+/****************************************************************
+ * REPLICAS.HPP
+ *
+ * This file contains the bit packed replicas related classes.
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file Replicas.hpp
+ *  \brief Disease state of an individual in 64 replicas packed in bit-planes.
+ */
+
+#ifndef REPLICAS_HPP_
+#define REPLICAS_HPP_
+
+#include <cstdint>
+#include <cmath>
+#include <boost/serialization/access.hpp>
+
+#include "repast_hpc/Random.h"
+
+const int REPLICA_LANES = 64;   //!< number of replicas packed in a ReplicaPlanes
+
+enum class state_inf : unsigned int { SUSCEPTIBLE = 1, LATENT = 2, INFECTIOUS_SYMPT = 3, INFECTIOUS_ASYMPT = 4, RECOVERED = 5 };
+
+
+//! \brief Disease state of an individual in 64 replicas (lanes), packed in 3 bit-planes.
+/*!
+  The state of a lane is coded on its bits of (b2, b1, b0) as state_inf - 1:
+  susceptible 000, latent 001, infectious symptomatic 010, infectious
+  asymptomatic 011 and recovered 100, so that the lanes in a state are given
+  by a few bitwise operations and the transitions of many lanes are done at
+  once.
+ */
+struct ReplicaPlanes {
+
+	uint64_t b0;   //!< bit 0 of the state of every lane
+	uint64_t b1;   //!< bit 1 of the state of every lane
+	uint64_t b2;   //!< bit 2 of the state of every lane
+
+	//! Return the susceptible lanes among some lanes.
+	uint64_t susceptible(uint64_t aLanes) const {
+		return aLanes & ~(b0 | b1 | b2);
+	}
+
+	//! Return the latent lanes.
+	uint64_t latent() const {
+		return b0 & ~b1;
+	}
+
+	//! Return the infectious (symptomatic or asymptomatic) lanes.
+	uint64_t infectious() const {
+		return b1;
+	}
+
+	//! Return the infectious symptomatic lanes.
+	uint64_t infectiousSympt() const {
+		return b1 & ~b0;
+	}
+
+	//! Return the infectious asymptomatic lanes.
+	uint64_t infectiousAsympt() const {
+		return b1 & b0;
+	}
+
+	//! Return the recovered lanes.
+	uint64_t recovered() const {
+		return b2;
+	}
+
+	//! Move susceptible lanes to the latent state.
+	void setLatent(uint64_t aLanes) {
+		b0 |= aLanes;
+	}
+
+	//! Move latent lanes to the infectious state, the asymptomatic ones being a subset of them.
+	void setInfectious(uint64_t aLanes, uint64_t aAsympt) {
+		b1 |= aLanes;
+		b0 = (b0 & ~aLanes) | aAsympt;
+	}
+
+	//! Move infectious lanes to the recovered state.
+	void setRecovered(uint64_t aLanes) {
+		b0 &= ~aLanes;
+		b1 &= ~aLanes;
+		b2 |= aLanes;
+	}
+
+	//! Return the state of a lane.
+	state_inf get(int aLane) const {
+		unsigned int code = ((b0 >> aLane) & 1) | (((b1 >> aLane) & 1) << 1) | (((b2 >> aLane) & 1) << 2);
+		return (state_inf)(code + 1);
+	}
+
+	//! Set the state of a lane.
+	void set(int aLane, state_inf aState) {
+		uint64_t bit = (uint64_t)1 << aLane;
+		unsigned int code = (unsigned int)aState - 1;
+		b0 = (code & 1) ? (b0 | bit) : (b0 & ~bit);
+		b1 = (code & 2) ? (b1 | bit) : (b1 & ~bit);
+		b2 = (code & 4) ? (b2 | bit) : (b2 & ~bit);
+	}
+
+	//! Serializing procedure of the planes.
+	template <class Archive>
+	void serialize ( Archive &ar , const unsigned int version ) {
+		ar &b0;
+		ar &b1;
+		ar &b2;
+	};
+
+};
+
+
+//! \brief Bernoulli draws of a fixed probability for many lanes at once.
+/*!
+  The draws use the uniform generator of Repast HPC, one per lane when few
+  lanes are drawn, otherwise the gaps between the successes over the 64
+  lanes, which needs about 64 p + 1 draws whatever the number of lanes.
+ */
+class LaneBernoulli {
+
+private:
+
+	double _p;       //!< probability of success
+	double _log_q;   //!< log(1 - p)
+
+public:
+
+	//! Constructor.
+	/*!
+	  \param aP the probability of success
+	 */
+	explicit LaneBernoulli(double aP = 0) : _p(aP), _log_q(aP < 1 ? std::log1p(-aP) : 0) {
+	}
+
+	//! Return the probability of success.
+	double getP() const {
+		return _p;
+	}
+
+	//! Return the lanes, among some lanes, where a draw succeeded.
+	uint64_t draw(uint64_t aLanes) const;
+
+};
+
+#endif /* REPLICAS_HPP_ */
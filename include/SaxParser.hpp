@@ -15,16 +15,81 @@
 
 class Model;
 
+//! Builds the agents of the model from the persons of an agenda.
+/*!
+  The attributes and the activities of the person being parsed are buffered
+  in a scratch record reused from one person to the next. Whether the person
+  is sampled is decided from its id (see isSampled), whether it is local at
+  its first activity, and an Individual is only allocated for the kept persons.
+ */
+class AgendaBuilder {
+
+private:
+  int                   _proc;              //!< rank of the process
+  Model&                _model;             //!< model receiving the agents
+  double                _sample_size;       //!< proportion of persons to keep
+  uint64_t              _sample_seed;       //!< seed of the sampling
+
+  // scratch record of the current person
+  int                   _id;
+  int                   _age_cl;
+  char                  _gender;
+  char                  _socio_pro_status;
+  char                  _edu_level;
+  std::vector<Activity> _agenda;
+  bool                  _in_person;         //!< a person is being parsed
+  bool                  _rejected;          //!< the current person will not be kept
+  int                   _house_id;          //!< current house node (see buildActivity)
+
+  long                  _n_persons;         //!< number of persons parsed
+  long                  _n_kept;            //!< number of persons added to the model
+
+public:
+  AgendaBuilder(int aProc, Model& aModel);
+
+  //! Start a new person.
+  void beginPerson(int aId, int aAgeCl, char aGender, char aSocioProStatus, char aEduLevel);
+
+  //! Return true if the activities of the current person are still needed.
+  bool wantsActivities() const {
+    return _in_person && !_rejected;
+  }
+
+  //! Return true if the current person will not be kept.
+  bool isRejected() const {
+    return _in_person && _rejected;
+  }
+
+  //! Add an activity to the current person (raw attributes, see buildActivity).
+  void addActivity(char aType, int aNodeId, int aEndTime, int aDuration);
+
+  //! End the current person, adding it to the model if it is kept.
+  void endPerson();
+
+  long getNPersons() const {
+    return _n_persons;
+  }
+
+  long getNKept() const {
+    return _n_kept;
+  }
+
+};
+
 class VBSaxParser : public xmlpp::SaxParser {
 
 private:
   int _proc;
-  Model& _model;
+  AgendaBuilder _builder;
   
 public:
   VBSaxParser(int aProc, Model& aModel);
   virtual ~VBSaxParser();
 
+  const AgendaBuilder& getBuilder() const {
+    return _builder;
+  }
+
 protected:
   //overrides:
   virtual void on_start_document();
@@ -38,11 +103,22 @@ protected:
   virtual void on_error(const Glib::ustring &text);
   virtual void on_fatal_error(const Glib::ustring &text);
 
-  Individual* on_individual(const AttributeList &properties);
-  void on_activity(const AttributeList& properties, Individual* ind);
+  void on_individual(const AttributeList &properties);
+  void on_activity(const AttributeList& properties);
   
 };
 
+//! Build an activity from the raw attributes of an act element (MATSim format).
+/*!
+  \param aType type of the activity
+  \param aNodeId original id of the node, -1 for the return to home
+  \param aEndTime ending time in seconds since midnight, -1 if none
+  \param aDuration duration in seconds, -1 if none
+  \param aHouseId internal id of the current house node, updated by the home activities
 
-#endif //__SAXPARSER_H
+  \return the activity, with the internal node id and its starting time
+ */
+Activity buildActivity(char aType, int aNodeId, int aEndTime, int aDuration, int& aHouseId);
 
+
+#endif //__SAXPARSER_H
@@ -0,0 +1,64 @@
+/****************************************************************
+ * SCENARIO.HPP
+ *
+ * This file contains the scenarios table related classes.
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file Scenario.hpp
+ *  \brief Table of the scenarios run from one initialized population.
+ */
+
+#ifndef SCENARIO_HPP_
+#define SCENARIO_HPP_
+
+#include <string>
+#include <vector>
+
+#include "repast_hpc/Properties.h"
+
+//! \brief Table of scenarios, each one overriding some model properties.
+/*!
+  The table is a csv file separated by ';' whose first line gives the
+  properties set by the scenarios (e.g. beta;p.a;random.seed) and every
+  following line the values of a scenario. The optional column "scenario"
+  names the scenario, which is otherwise named scenario_<line>. Empty lines
+  and lines starting with '#' are ignored.
+ */
+class ScenarioTable {
+
+private:
+
+	std::vector<std::string>               _keys;    //!< properties set by the scenarios
+	std::vector<std::vector<std::string> > _rows;    //!< values of every scenario
+	int                                    _name;    //!< column of the scenario names (-1 if none)
+
+public:
+
+	//! Constructor, reads the table.
+	/*!
+	  \param aFilename the csv file
+
+	  Throws a std::runtime_error if the file cannot be read or a line does not have one value per property.
+	 */
+	explicit ScenarioTable(const std::string& aFilename);
+
+	//! Return the number of scenarios.
+	size_t size() const {
+		return _rows.size();
+	}
+
+	//! Return the name of a scenario.
+	std::string getName(size_t aScenario) const;
+
+	//! Set the properties of a scenario.
+	/*!
+	  \param aScenario the scenario
+	  \param aProps the properties to update
+	 */
+	void apply(size_t aScenario, repast::Properties& aProps) const;
+
+};
+
+#endif /* SCENARIO_HPP_ */
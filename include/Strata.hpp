@@ -0,0 +1,155 @@
+/****************************************************************
+ * STRATA.HPP
+ *
+ * This file contains the stratified aggregate output related
+ * classes.
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file Strata.hpp
+ *  \brief Counts of individuals per infection state and stratum.
+ */
+
+#ifndef STRATA_HPP_
+#define STRATA_HPP_
+
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <boost/mpi/communicator.hpp>
+
+#include "repast_hpc/Properties.h"
+#include "Individual.hpp"
+
+//! Attribute of the individuals used to define the strata.
+enum StrataAttribute {
+	STRATA_AGE_CL,        //!< age class
+	STRATA_GENDER,        //!< gender
+	STRATA_SPS_STATUS,    //!< socio-professional status
+	STRATA_EDU_LEVEL,     //!< education level
+	STRATA_ACTIVITY       //!< type of the current activity
+};
+
+const int N_STATES = 5;   //!< number of infection states (see state_inf)
+
+
+//! \brief Counts of individuals per infection state and stratum.
+/*!
+  A stratum is a combination of values of the attributes listed in
+  output.strata (e.g. age_cl,gender,activity). The counts are a dense
+  state x stratum tensor updated on every change of state or current
+  activity, so no pass over the agents is needed to output them.
+
+  The counts of a process are the changes that happened on it: an agent
+  moving to another process is counted by the process where each of its
+  changes happened, and only the sum over all the processes, written by
+  the process 0, is a count of individuals.
+ */
+class StrataCounts {
+
+private:
+
+	//! An attribute and its values.
+	struct Dimension {
+		StrataAttribute     attribute;   //!< attribute of the individuals
+		std::string         name;        //!< name of the attribute in the properties and output
+		std::vector<int>    values;      //!< values of the attribute, the other values being counted together
+		std::map<int, int>  index;       //!< index of every value
+		int                 stride;      //!< stride of the attribute in the strata
+	};
+
+	std::vector<Dimension>  _dims;       //!< attributes defining the strata
+	int                     _n_strata;   //!< number of strata
+	std::vector<int>        _counts;     //!< counts, _n_strata per state
+	bool                    _activity;   //!< true if the strata depend on the current activity
+	int                     _interval;   //!< number of ticks between two outputs
+	int                     _proc;       //!< rank of the process
+	std::ofstream           _out;        //!< output file (process 0 only)
+
+	//! Return the value of an attribute of an individual.
+	static int getValue(const Individual& aInd, StrataAttribute aAttribute);
+
+	//! Add the values taken by the attributes of an individual.
+	void collectValues(const Individual& aInd, std::vector<std::set<int> >& aValues) const;
+
+	//! Set the values of the attributes not given in the properties, from the values of all processes.
+	void setup(std::vector<std::set<int> >& aValues, const boost::mpi::communicator& aComm);
+
+	//! Return the position of a count.
+	int getIndex(state_inf aState, int aStratum) const {
+		return (static_cast<int>(aState) - 1) * _n_strata + aStratum;
+	}
+
+public:
+
+	//! Constructor.
+	/*!
+	  \param aProps the model properties (output.strata and output.strata.<attribute>)
+	  \param aFilename the output file
+	  \param aInterval the number of ticks between two outputs
+	  \param aProc the rank of the process
+
+	  Throws a std::runtime_error if an attribute is unknown.
+	 */
+	StrataCounts(const repast::Properties& aProps, const std::string& aFilename, int aInterval, int aProc);
+
+	//! Count the initial agents of the process (collective).
+	/*!
+	  \param aBegin first agent
+	  \param aEnd end of the agents
+	  \param aComm the communicator of the simulation
+	 */
+	template<typename Iterator>
+	void init(Iterator aBegin, Iterator aEnd, const boost::mpi::communicator& aComm) {
+		std::vector<std::set<int> > values(_dims.size());
+		for( Iterator it = aBegin; it != aEnd; ++it ) collectValues(**it, values);
+		setup(values, aComm);
+		for( Iterator it = aBegin; it != aEnd; ++it ) add(**it);
+	}
+
+	//! Return the stratum of an individual.
+	int getStratum(const Individual& aInd) const;
+
+	//! Count an individual.
+	void add(const Individual& aInd) {
+		_counts[getIndex(aInd.getState(), getStratum(aInd))]++;
+	}
+
+	//! Move an individual from its previous state to its current one.
+	void changeState(const Individual& aInd, state_inf aPreviousState) {
+		int stratum = getStratum(aInd);
+		_counts[getIndex(aPreviousState, stratum)]--;
+		_counts[getIndex(aInd.getState(), stratum)]++;
+	}
+
+	//! Move an individual from its previous stratum to its current one.
+	void changeStratum(const Individual& aInd, int aPreviousStratum) {
+		int stratum = getStratum(aInd);
+		if( stratum == aPreviousStratum ) return;
+		_counts[getIndex(aInd.getState(), aPreviousStratum)]--;
+		_counts[getIndex(aInd.getState(), stratum)]++;
+	}
+
+	//! Return true if the strata depend on the current activity.
+	bool usesActivity() const {
+		return _activity;
+	}
+
+	//! Return the number of ticks between two outputs.
+	int getInterval() const {
+		return _interval;
+	}
+
+	//! Sum the counts of all processes and write them (collective).
+	/*!
+	  \param aTick the current tick
+	  \param aComm the communicator of the simulation
+	 */
+	void write(double aTick, const boost::mpi::communicator& aComm);
+
+};
+
+#endif /* STRATA_HPP_ */
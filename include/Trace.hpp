@@ -0,0 +1,180 @@
+/****************************************************************
+ * TRACE.HPP
+ *
+ * This file contains the timeline tracing related classes.
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file Trace.hpp
+ *  \brief Timeline of the phases of the simulation steps and of the MPI
+ *  exchanges of every process, in the Chrome trace format.
+ */
+
+#ifndef TRACE_HPP_
+#define TRACE_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mpi.h>
+
+//! \brief Timeline of the step phases and MPI exchanges of a process.
+/*!
+  The begin and end of the traced phases are recorded in a ring buffer
+  (only the last events being kept when it is full) for the ticks of a
+  window. The clocks of the processes are aligned on the clock of the
+  process 0 when the recorder is enabled, so the timelines of the processes
+  can be compared, e.g. to see the processes waiting for the others in the
+  agents synchronization.
+
+  The per agent phases (category agent) are only recorded for a sample of
+  the agents (see sample()), as recording them for every agent would fill
+  the buffer in a few ticks.
+
+  The timeline of all the processes is written in the Chrome trace event
+  format, read by chrome://tracing and https://ui.perfetto.dev.
+
+  The recorder is enabled by log.trace, and compiled out with the step
+  timers (-DNO_STEP_TIMERS, see StepProfiler).
+ */
+class TraceRecorder {
+
+private:
+
+	typedef std::chrono::steady_clock Clock;
+
+	//! A traced phase.
+	struct Event {
+		const char* name;       //!< name of the phase
+		const char* category;   //!< category of the phase (step, agent, mpi, io)
+		int64_t     begin;      //!< begin in ns on the clock of the process 0
+		int64_t     end;        //!< end in ns on the clock of the process 0
+		int         tick;       //!< tick of the phase
+	};
+
+	bool               _enabled;    //!< true if the events of the window are recorded
+	bool               _recording;  //!< true if the current tick is in the window
+	int                _from;       //!< first tick of the window
+	int                _to;         //!< last tick of the window
+	int                _tick;       //!< current tick
+	int                _sampling;   //!< 1 agent out of _sampling has its phases recorded
+	int                _countdown;  //!< agents before the next sampled one
+	std::vector<Event> _events;     //!< ring buffer of the events
+	uint64_t           _n_events;   //!< number of events recorded
+	int64_t            _offset;     //!< offset of the clock of the process to the clock of the process 0 in ns (minus the origin of the times)
+
+	TraceRecorder() : _enabled(false), _recording(false), _from(0), _to(0), _tick(0), _sampling(1), _countdown(1), _events(),
+		_n_events(0), _offset(0) {}
+
+	//! Estimate the offset of the clock of every process to the clock of the process 0.
+	/*!
+	  The process 0 answers some pings of every other process with its
+	  clock, the offset being estimated from the ping with the shortest round
+	  trip.
+	 */
+	void synchronizeClocks(MPI_Comm aComm);
+
+public:
+
+	//! Return the recorder of the process.
+	static TraceRecorder& instance();
+
+	//! Enable the recorder, synchronizing the clocks of the processes (collective).
+	/*!
+	  \param aCapacity the number of events kept
+	  \param aSampling the per agent phases being recorded for 1 agent out of aSampling
+	  \param aFrom the first tick traced
+	  \param aTo the last tick traced
+	  \param aComm the communicator of the processes traced
+	 */
+	void enable(size_t aCapacity, int aSampling, int aFrom, int aTo, MPI_Comm aComm);
+
+	//! Set the current tick, starting or stopping the recording.
+	void setTick(int aTick) {
+		_tick = aTick;
+		_recording = _enabled && _from <= aTick && aTick <= _to;
+	}
+
+	//! Return true if the events of the current tick are recorded.
+	bool isRecording() const {
+#ifdef NO_STEP_TIMERS
+		return false;
+#else
+		return _recording;
+#endif
+	}
+
+	//! Return true if the phases of the current agent are recorded, to be called once per agent.
+	bool sample() {
+		if( !isRecording() || --_countdown > 0 ) return false;
+		_countdown = _sampling;
+		return true;
+	}
+
+	//! Return the current time in ns on the clock of the process 0, from when the recorder was enabled.
+	int64_t now() const {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count() + _offset;
+	}
+
+	//! Record a phase.
+	/*!
+	  \param aName the name of the phase (a string literal)
+	  \param aCategory the category of the phase (a string literal)
+	  \param aBegin the begin of the phase (see now())
+	 */
+	void add(const char* aName, const char* aCategory, int64_t aBegin) {
+		Event event = { aName, aCategory, aBegin, now(), _tick };
+		_events[_n_events % _events.size()] = event;
+		_n_events++;
+	}
+
+	//! Write the timeline of all the processes in a Chrome trace file (collective, each process writing its events with MPI-IO).
+	/*!
+	  \param aFilename the trace file
+	  \param aComm the communicator of the processes traced
+	  \param aRank the rank shown for the process (e.g. its rank in MPI_COMM_WORLD)
+	 */
+	void write(const std::string& aFilename, MPI_Comm aComm, int aRank) const;
+
+};
+
+
+//! \brief Traced phase, from its construction to its destruction.
+class ScopedTrace {
+
+#ifndef NO_STEP_TIMERS
+private:
+
+	const char* _name;       //!< name of the phase
+	const char* _category;   //!< category of the phase
+	int64_t     _begin;      //!< begin of the phase (-1: not recorded)
+
+public:
+
+	//! Constructor.
+	/*!
+	  \param aName the name of the phase (a string literal)
+	  \param aCategory the category of the phase (a string literal)
+	  \param aRecorded false if the phase is not recorded (e.g. an agent out of the sample)
+	 */
+	explicit ScopedTrace(const char* aName, const char* aCategory = "step", bool aRecorded = true) :
+		_name(aName), _category(aCategory),
+		_begin(aRecorded && TraceRecorder::instance().isRecording() ? TraceRecorder::instance().now() : -1) {
+	}
+
+	//! Destructor, recording the phase.
+	~ScopedTrace() {
+		if( _begin >= 0 ) TraceRecorder::instance().add(_name, _category, _begin);
+	}
+#else
+public:
+
+	explicit ScopedTrace(const char* aName, const char* aCategory = "step", bool aRecorded = true) {
+	}
+#endif
+
+};
+
+#endif /* TRACE_HPP_ */
@@ -0,0 +1,147 @@
+/****************************************************************
+ * TRANSMISSIONLOG.HPP
+ *
+ * This file contains the transmission events output related
+ * classes.
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file TransmissionLog.hpp
+ *  \brief Per process binary log of the transmission events.
+ *
+ *  A transmission file holds the infections of the agents on a process,
+ *  in the order they happened. Its layout is
+ *  - a TransmissionHeader;
+ *  - fixed-width TransmissionRecord until the end of the file.
+ *
+ *  The files of all the processes are merged in a single file sorted by
+ *  tick and infectee with the merge_transmissions tool.
+ */
+
+#ifndef TRANSMISSIONLOG_HPP_
+#define TRANSMISSIONLOG_HPP_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Individual.hpp"
+
+const char     TRANSMISSION_MAGIC[8] = { 'V', 'B', 'T', 'R', 'A', 'N', 'S', 0 }; //!< magic number of a transmission file
+const uint32_t TRANSMISSION_VERSION  = 1;                                      //!< current version of the format
+
+//! Header of a transmission file.
+struct TransmissionHeader {
+	char     magic[8];            //!< TRANSMISSION_MAGIC
+	uint32_t version;             //!< TRANSMISSION_VERSION
+	uint32_t record_size;         //!< sizeof(TransmissionRecord)
+	int32_t  rank;                //!< rank of the process that wrote the file (-1 for a merged file)
+	int32_t  n_proc;              //!< number of processes of the simulation
+};
+
+//! Fixed-width transmission event.
+struct TransmissionRecord {
+	int32_t  tick;                //!< tick of the infection
+	int32_t  infector;            //!< id of the infectious individual
+	int32_t  infectee;            //!< id of the individual becoming latent
+	int32_t  node;                //!< internal id of the node where the infection happened
+	uint8_t  infector_state;      //!< state of the infector (see state_inf)
+	uint8_t  padding[3];
+};
+
+static_assert(sizeof(TransmissionHeader) == 24, "unexpected TransmissionHeader layout");
+static_assert(sizeof(TransmissionRecord) == 20, "unexpected TransmissionRecord layout");
+
+
+//! \brief Buffered writer of the transmission events of a process.
+/*!
+  The events are appended to an in-memory buffer; a full buffer is handed
+  over to a background thread writing it to the file while the simulation
+  fills the next one. The simulation only waits if all the buffers are
+  being written.
+ */
+class TransmissionLog {
+
+private:
+
+	std::string                                   _filename;   //!< name of the file
+	FILE*                                         _file;       //!< the file (NULL once closed)
+	std::vector<std::vector<TransmissionRecord> > _buffers;    //!< buffers pool
+	std::vector<size_t>                           _sizes;      //!< number of records held by each buffer
+	std::deque<int>                               _free;       //!< buffers ready to be filled
+	std::deque<int>                               _full;       //!< buffers ready to be written, in events order
+	int                                           _current;    //!< buffer being filled by the simulation
+	size_t                                        _n_current;  //!< number of records in the current buffer
+	uint64_t                                      _n_records;  //!< number of records added so far
+	bool                                          _stop;       //!< true to request the writer to stop once all buffers are written
+	std::string                                   _error;      //!< error raised by the writer, if any
+	std::mutex                                    _mutex;      //!< protects the queues and flags
+	std::condition_variable                       _cond_free;  //!< signaled when a buffer is written
+	std::condition_variable                       _cond_full;  //!< signaled when a buffer is filled or on close
+	std::thread                                   _writer;     //!< writing thread
+
+	TransmissionLog(const TransmissionLog&);
+	TransmissionLog& operator=(const TransmissionLog&);
+
+	//! Body of the writer thread.
+	void write();
+
+	//! Hand the current buffer over to the writer and take a free one.
+	void submit();
+
+public:
+
+	//! Constructor, creates the file and starts the writer thread.
+	/*!
+	  \param aFilename the output file
+	  \param aRank the rank of the process
+	  \param aNProc the number of processes
+	  \param aBufferSize the number of records of each buffer
+	  \param aNBuffers the number of buffers
+
+	  Throws a std::runtime_error if the file cannot be created.
+	 */
+	TransmissionLog(const std::string& aFilename, int aRank, int aNProc, size_t aBufferSize = 1 << 16, int aNBuffers = 3);
+
+	//! Destructor, closes the file.
+	~TransmissionLog();
+
+	//! Append a transmission event.
+	/*!
+	  \param aTick the current tick
+	  \param aInfector the id of the infectious individual
+	  \param aInfectee the id of the infected individual
+	  \param aNode the internal id of the node
+	  \param aInfectorState the state of the infectious individual
+	 */
+	void add(int aTick, int aInfector, int aInfectee, int aNode, state_inf aInfectorState) {
+		TransmissionRecord& r = _buffers[_current][_n_current];
+		r.tick           = aTick;
+		r.infector       = aInfector;
+		r.infectee       = aInfectee;
+		r.node           = aNode;
+		r.infector_state = static_cast<uint8_t>(aInfectorState);
+		_n_records++;
+		if( ++_n_current == _buffers[_current].size() ) submit();
+	}
+
+	//! Write the remaining events and close the file.
+	/*!
+	  Throws a std::runtime_error if the events could not be written.
+	 */
+	void close();
+
+	//! Return the number of events added so far.
+	uint64_t getNRecords() const {
+		return _n_records;
+	}
+
+};
+
+#endif /* TRANSMISSIONLOG_HPP_ */
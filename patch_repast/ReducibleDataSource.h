@@ -42,6 +42,8 @@
 #define REDUCEABLEDATASOURCE_H_
 
 #include <vector>
+#include <algorithm>
+#include <typeinfo>
 #include <boost/mpi.hpp>
 
 #include "TDataSource.h"
@@ -72,10 +74,14 @@ public:
 	~ReducibleDataSource();
 
 	virtual void record();
-	virtual void write(Variable* var);
 	virtual SVDataSource::DataType type() const {
 		return data_type_traits<T>::data_type();
 	}
+	virtual std::string reductionKey() const {
+		return std::string(typeid(Op).name()) + "/" + typeid(T).name();
+	}
+	virtual SVReduction* reduce(const std::vector<SVDataSource*>& group, size_t valuesPerRow, size_t nRows, bool stats,
+			const std::vector<Variable**>& columns, bool nonBlocking);
 };
 
 template<typename Op, typename T>
@@ -94,19 +100,126 @@ void ReducibleDataSource<Op, T>::record() {
 	data.push_back(_dataSource->getData());
 }
 
+/**
+ * Posts a non-blocking reduction when Op is a MPI operation on T.
+ */
+template<typename Op, typename T, bool IsMpiOp = boost::mpi::is_mpi_op<Op, T>::value>
+struct nonblocking_reduce {
+	static bool post(const T*, T*, int, MPI_Comm, MPI_Request*) {
+		return false;
+	}
+};
+
+template<typename Op, typename T>
+struct nonblocking_reduce<Op, T, true> {
+	static bool post(const T* in, T* out, int n, MPI_Comm comm, MPI_Request* request) {
+		MPI_Ireduce(const_cast<T*>(in), out, n, boost::mpi::get_mpi_datatype<T>(T()), boost::mpi::is_mpi_op<Op, T>::op(),
+				0, comm, request);
+		return true;
+	}
+};
+
+/**
+ * Reduction of the packed values of a group of ReducibleDataSources.
+ */
+template<typename Op, typename T>
+class PackedReduction : public SVReduction {
+
+private:
+	Op _op;
+	std::vector<T> packed;
+	std::vector<T> results;
+	size_t valuesPerRow, nRows, nSources;
+	bool stats;
+	std::vector<Variable**> columns;
+	int rank;
+	MPI_Request request;
+	bool done;
+
+public:
+	PackedReduction(Op op, std::vector<T>& values, size_t valuesPerRow, size_t nRows, size_t nSources, bool stats,
+			const std::vector<Variable**>& columns, bool nonBlocking);
+	virtual bool test();
+	virtual void complete();
+};
+
 template<typename Op, typename T>
-void ReducibleDataSource<Op, T>::write(Variable* var) {
+PackedReduction<Op, T>::PackedReduction(Op op, std::vector<T>& values, size_t valuesPerRow, size_t nRows, size_t nSources,
+		bool stats, const std::vector<Variable**>& columns, bool nonBlocking) : _op(op), valuesPerRow(valuesPerRow),
+		nRows(nRows), nSources(nSources), stats(stats), columns(columns), request(MPI_REQUEST_NULL), done(false) {
+	packed.swap(values);
+	rank = RepastProcess::instance()->rank();
+	if (rank == 0) results.resize(packed.size());
+
 	boost::mpi::communicator* comm = RepastProcess::instance()->getCommunicator();
+	if (nonBlocking && nonblocking_reduce<Op, T>::post(packed.data(), results.data(), packed.size(), *comm, &request)) return;
+
 	if (rank == 0) {
-		size_t size = data.size();
-		T* results = new T[size];
-		reduce(*comm, &data[0], size, results, _op, 0);
-		var->insert(results, size);
-		delete[] results;
+		boost::mpi::reduce(*comm, packed.data(), packed.size(), results.data(), _op, 0);
 	} else {
-		reduce(*comm, &data[0], data.size(), _op, 0);
+		boost::mpi::reduce(*comm, packed.data(), packed.size(), _op, 0);
+	}
+	done = true;
+}
+
+template<typename Op, typename T>
+bool PackedReduction<Op, T>::test() {
+	if (!done) {
+		int flag = 0;
+		MPI_Test(&request, &flag, MPI_STATUS_IGNORE);
+		done = flag != 0;
+	}
+	return done;
+}
+
+template<typename Op, typename T>
+void PackedReduction<Op, T>::complete() {
+	if (!done) {
+		MPI_Wait(&request, MPI_STATUS_IGNORE);
+		done = true;
+	}
+	if (rank != 0) return;
+
+	// each row is the last value of its interval, followed by the min, max and mean over the interval
+	size_t n = valuesPerRow * nRows;
+	for (size_t g = 0; g < nSources; g++) {
+		const T* values = results.data() + g * n;
+		std::vector<T> last(nRows), min(nRows), max(nRows);
+		std::vector<double> mean(nRows);
+		for (size_t r = 0; r < nRows; r++) {
+			const T* row = values + r * valuesPerRow;
+			last[r] = row[valuesPerRow - 1];
+			min[r] = *std::min_element(row, row + valuesPerRow);
+			max[r] = *std::max_element(row, row + valuesPerRow);
+			double sum = 0;
+			for (size_t v = 0; v < valuesPerRow; v++) sum += row[v];
+			mean[r] = sum / valuesPerRow;
+		}
+		Variable** vars = columns[g];
+		vars[0]->insert(last.data(), nRows);
+		if (stats) {
+			vars[1]->insert(min.data(), nRows);
+			vars[2]->insert(max.data(), nRows);
+			vars[3]->insert(mean.data(), nRows);
+		}
+	}
+}
+
+template<typename Op, typename T>
+SVReduction* ReducibleDataSource<Op, T>::reduce(const std::vector<SVDataSource*>& group, size_t valuesPerRow, size_t nRows,
+		bool stats, const std::vector<Variable**>& columns, bool nonBlocking) {
+
+	// packing the values of the group, the sources share the type of this one
+	size_t n = valuesPerRow * nRows;
+	std::vector<T> packed(n * group.size());
+	for (size_t g = 0; g < group.size(); g++) {
+		ReducibleDataSource<Op, T>* source = static_cast<ReducibleDataSource<Op, T>*>(group[g]);
+		std::copy(source->data.begin(), source->data.begin() + n, packed.begin() + g * n);
+		source->data.erase(source->data.begin(), source->data.begin() + n);
 	}
-	data.clear();
+
+	return new PackedReduction<Op, T>(_op, packed, valuesPerRow, nRows, group.size(), stats, columns, nonBlocking);
+
 }
 
 }
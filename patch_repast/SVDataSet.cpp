@@ -52,7 +52,8 @@ namespace fs = boost::filesystem;
 namespace repast {
 
 SVDataSet::SVDataSet(const std::string& file, const std::string& separator, const Schedule* schedule) :
-	_separator(separator), _schedule(schedule), out(), open(true) {
+	_separator(separator), _schedule(schedule), out(), open(true), nRecords(0), recordInterval(1), stats(false),
+	ticksInInterval(0), nonBlocking(false) {
 	rank = RepastProcess::instance()->rank();
 	if (rank == 0) {
 	  fs::path filepath(file);
@@ -76,6 +77,7 @@ SVDataSet::~SVDataSet() {
 
 void SVDataSet::close() {
 	if (open) {
+		flush();
 		if (rank == 0) {
 			out.close();
 		}
@@ -104,6 +106,14 @@ void SVDataSet::init() {
 				var = new DoubleVariable();
 			vars.push_back(var);
 			out << _separator << "\"" << ds->name() << "\"";
+			if (stats) {
+				vars.push_back(type == SVDataSource::INT ? (Variable*) new IntVariable() : (Variable*) new DoubleVariable());
+				vars.push_back(type == SVDataSource::INT ? (Variable*) new IntVariable() : (Variable*) new DoubleVariable());
+				vars.push_back(new DoubleVariable());
+				out << _separator << "\"" << ds->name() << "_min\"";
+				out << _separator << "\"" << ds->name() << "_max\"";
+				out << _separator << "\"" << ds->name() << "_mean\"";
+			}
 		}
 		out << std::endl;
 		out.flush();
@@ -112,28 +122,75 @@ void SVDataSet::init() {
 
 void SVDataSet::record() {
 	if (!open) throw Repast_Error_28(); // Data set not open
+
+	// progressing the oldest write in flight, its rows are written as soon as it is done
+	if (!pending.empty()) {
+		bool done = true;
+		for (size_t i = 0; i < pending.front().reductions.size(); i++) {
+			done = pending.front().reductions[i]->test() && done;
+		}
+		if (done) completeWrite();
+	}
+
+	// the statistics need every value of the interval, otherwise only its last one is kept
+	if (stats || ticksInInterval == recordInterval - 1) {
+		for (size_t i = 0; i < dataSources.size(); i++) {
+			dataSources[i]->record();
+		}
+	}
+	if (++ticksInInterval < recordInterval) return;
+	ticksInInterval = 0;
+
 	if (rank == 0) {
 		ticks.push_back(_schedule->getCurrentTick());
 	}
-	for (size_t i = 0; i < dataSources.size(); i++) {
-		dataSources[i]->record();
-	}
+	nRecords++;
 }
 
 void SVDataSet::write() {
 	if (!open) throw Repast_Error_29();
+	// every process records at the same ticks, so they all skip the reductions together
+	if (nRecords == 0) return;
+
+	// at most two writes in flight: the oldest one is completed before posting a third one
+	if (pending.size() >= 2) completeWrite();
+
+	// grouping the data sources by reduction, in the order of their first column
+	PendingWrite write;
+	write.ticks.swap(ticks);
+	size_t columnsPerSource = stats ? 4 : 1;
+	std::vector<bool> reduced(dataSources.size(), false);
 	for (size_t i = 0; i < dataSources.size(); i++) {
-		SVDataSource * ds = dataSources[i];
-		Variable* var = 0;
-		if (rank == 0) {
-			var = vars[i];
+		if (reduced[i]) continue;
+		std::vector<SVDataSource*> group;
+		std::vector<Variable**> columns;
+		std::string key = dataSources[i]->reductionKey();
+		for (size_t j = i; j < dataSources.size(); j++) {
+			if (!reduced[j] && dataSources[j]->reductionKey() == key) {
+				reduced[j] = true;
+				group.push_back(dataSources[j]);
+				columns.push_back(rank == 0 ? &vars[j * columnsPerSource] : (Variable**) 0);
+			}
 		}
-		ds->write(var);
+		write.reductions.push_back(dataSources[i]->reduce(group, stats ? recordInterval : 1, nRecords, stats, columns,
+				nonBlocking));
+	}
+	pending.push_back(write);
+	if (!nonBlocking) completeWrite();
+
+	nRecords = 0;
+}
+
+void SVDataSet::completeWrite() {
+	PendingWrite& write = pending.front();
+	for (size_t i = 0; i < write.reductions.size(); i++) {
+		write.reductions[i]->complete();
+		delete write.reductions[i];
 	}
 
 	if (rank == 0) {
-		for (size_t ti = 0, k = ticks.size(); ti < k; ++ti) {
-			out << ticks[ti];
+		for (size_t ti = 0, k = write.ticks.size(); ti < k; ++ti) {
+			out << write.ticks[ti];
 			for (size_t i = 0, n = vars.size(); i < n; ++i) {
 				Variable* var = vars[i];
 				out << _separator;
@@ -148,7 +205,13 @@ void SVDataSet::write() {
 		out.flush();
 	}
 
-	ticks.clear();
+	pending.pop_front();
+}
+
+void SVDataSet::flush() {
+	while (!pending.empty()) {
+		completeWrite();
+	}
 }
 
 }
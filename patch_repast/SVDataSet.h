@@ -43,6 +43,7 @@
 
 #include <fstream>
 #include <vector>
+#include <deque>
 
 #include "Schedule.h"
 #include "Variable.h"
@@ -73,9 +74,24 @@ private:
 	std::ofstream out;
 	bool open;
 	int rank;
+	size_t nRecords; // rows recorded since the last write, identical on every process
+	int recordInterval; // number of record() calls per row
+	bool stats; // rows with the min, max and mean over their interval
+	int ticksInInterval; // record() calls since the last row
+	bool nonBlocking; // reductions overlapped with the next ticks
+
+	// a write whose reductions may still be in progress
+	struct PendingWrite {
+		std::vector<double> ticks;
+		std::vector<SVReduction*> reductions;
+	};
+	std::deque<PendingWrite> pending;
 
 	void init();
 
+	// waits for the oldest pending write and writes its rows
+	void completeWrite();
+
 	/**
 	 * Creates a DataSet that will write to the specified file and use the specified
 	 * string as a data value separator. Tick info will be gathered from the specified schedule.
@@ -88,17 +104,30 @@ public:
 	~SVDataSet();
 
 	/**
-	 * Records data from any added data sources.
+	 * Records data from any added data sources. A row is added every
+	 * recordInterval calls (see SVDataSetBuilder::setRecordInterval).
 	 */
 	void record();
 
 	/**
-	 * Writes any recorded data to a file.
+	 * Writes any recorded data to a file. It can be called repeatedly, each call
+	 * appending the rows recorded since the previous one. Does nothing, and
+	 * performs no reduction, if nothing was recorded since the previous call.
+	 * The data sources sharing the same reduction are reduced together with a
+	 * single collective. The values of an interval not completed yet are kept
+	 * for the next call. With non-blocking reductions (see
+	 * SVDataSetBuilder::setNonBlocking), the rows are written once their
+	 * reductions are done, at a later record(), write() or flush().
 	 */
 	void write();
 
 	/**
-	 * Closes the data set.
+	 * Waits for the writes still in progress and writes their rows.
+	 */
+	void flush();
+
+	/**
+	 * Closes the data set, flushing it first.
 	 */
 	void close();
 };
@@ -54,6 +54,19 @@ SVDataSetBuilder& SVDataSetBuilder::addDataSource(SVDataSource* source) {
 	return *this;
 }
 
+SVDataSetBuilder& SVDataSetBuilder::setRecordInterval(int interval, bool stats) {
+	if (returned) throw Repast_Error_33(); // the data set is already initialized
+	dataSet->recordInterval = interval > 0 ? interval : 1;
+	dataSet->stats = stats;
+	return *this;
+}
+
+SVDataSetBuilder& SVDataSetBuilder::setNonBlocking(bool nonBlocking) {
+	if (returned) throw Repast_Error_33(); // the data set is already initialized
+	dataSet->nonBlocking = nonBlocking;
+	return *this;
+}
+
 SVDataSet* SVDataSetBuilder::createDataSet() {
 	if (returned) throw Repast_Error_34(); // DataSetBuilder can only create a single dataset
 	dataSet->init();
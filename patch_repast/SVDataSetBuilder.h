@@ -130,6 +130,27 @@ public:
 	 */
 	SVDataSetBuilder& addDataSource(SVDataSource* source);
 
+	/**
+	 * Sets the number of calls to record() between two rows of the data set (1 by default).
+	 * Each row holds the values recorded at the last call of its interval and, if stats is
+	 * true, the min, max and mean of the values recorded during the interval.
+	 *
+	 * @param interval the number of record() calls per row
+	 * @param stats true to add the min, max and mean columns
+	 */
+	SVDataSetBuilder& setRecordInterval(int interval, bool stats);
+
+	/**
+	 * Sets whether the reductions of the data set are non-blocking (false by default).
+	 * The reductions using a MPI operation are then posted by write() and completed
+	 * during the next calls to record(), at most two writes being in flight. The output
+	 * is identical to the blocking one. SVDataSet::flush() must be called before the
+	 * end of the simulation.
+	 *
+	 * @param nonBlocking true for non-blocking reductions
+	 */
+	SVDataSetBuilder& setNonBlocking(bool nonBlocking);
+
 	/**
 	 * Creates the DataSource defined by this builder. This can only be called once.
 	 * The caller is responsible for properly deleting the returned pointer.
@@ -42,11 +42,31 @@
 #define SVDATASOURCE_H_
 
 #include <fstream>
+#include <string>
+#include <vector>
 
 #include "Variable.h"
 
 namespace repast {
 
+/**
+ * Reduction of the values of data sources, possibly still in progress.
+ */
+class SVReduction {
+public:
+	virtual ~SVReduction() {}
+
+	/**
+	 * Returns true if the reduction is done, progressing it otherwise.
+	 */
+	virtual bool test() = 0;
+
+	/**
+	 * Waits for the reduction and, on rank 0, inserts the rows into the columns.
+	 */
+	virtual void complete() = 0;
+};
+
 /**
  * Data source for data to be written into separated-value
  * data sets.
@@ -62,9 +82,34 @@ public:
 	SVDataSource(const std::string& name) : _name(name) {}
 	virtual ~SVDataSource() {};
 	virtual void record() = 0;
-	virtual void write(Variable* var) = 0;
 	virtual DataType type() const = 0;
 
+	/**
+	 * Gets the key of the reduction of this data source. Data sources with the
+	 * same key use the same (stateless) operation on the same type, and can be
+	 * reduced together.
+	 */
+	virtual std::string reductionKey() const = 0;
+
+	/**
+	 * Starts the reduction with a single collective of the first valuesPerRow * nRows
+	 * recorded values of every data source of a group (sharing this data source's
+	 * reduction key) and removes them from the data sources.
+	 *
+	 * @param group the data sources to reduce, this one included
+	 * @param valuesPerRow the number of recorded values in a row
+	 * @param nRows the number of rows to reduce
+	 * @param stats true if the rows are written with their min, max and mean
+	 * @param columns on rank 0, the first column (1 or 4 variables with stats) of
+	 * every data source of the group
+	 * @param nonBlocking true to use a non-blocking collective when the operation
+	 * is a MPI one, the reduction is otherwise done before returning
+	 *
+	 * @return the reduction, to be completed and deleted by the caller
+	 */
+	virtual SVReduction* reduce(const std::vector<SVDataSource*>& group, size_t valuesPerRow, size_t nRows, bool stats,
+			const std::vector<Variable**>& columns, bool nonBlocking) = 0;
+
 	const std::string name() const {
 		return _name;
 	}
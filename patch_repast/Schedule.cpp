@@ -90,12 +90,17 @@ bool RepeatingEvent::reschedule(
 }
 
 Schedule::~Schedule() {
+	clear();
+}
+
+void Schedule::clear() {
 	while (!queue.empty()) {
 		ScheduledEvent *evt = queue.top();
 
 		queue.pop();
 		delete evt;
 	}
+	currentTick = 0;
 }
 
 ScheduledEvent* Schedule::schedule_event(double start, FunctorPtr func) {
@@ -171,6 +176,13 @@ void ScheduleRunner::stop() {
 	go = false;
 }
 
+void ScheduleRunner::reset() {
+	schedule_.clear();
+	endEvents.clear();
+	go = true;
+	nextTick();
+}
+
 void ScheduleRunner::scheduleEndEvent(Schedule::FunctorPtr func) {
 	endEvents.push_back(func);
 }
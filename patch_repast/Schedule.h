@@ -206,6 +206,11 @@ public:
 	ScheduledEvent* schedule_event(double start, double interval, FunctorPtr func);
 	void execute();
 
+	/**
+	 * Removes all the scheduled events and sets the current tick back to 0.
+	 */
+	void clear();
+
 	/**
 	 * Gets the current simulation tick.
 	 *
@@ -305,6 +310,12 @@ public:
 	 */
 	void stop();
 
+	/**
+	 * Removes all the scheduled events and end events, so that a new simulation
+	 * can be scheduled and run from tick 0.
+	 */
+	void reset();
+
 	/**
 	 * Gets the schedule executed by this simulation runner.
 	 *
@@ -0,0 +1,267 @@
+/****************************************************************
+ * AGENDASCANNER.CPP
+ *
+ * This file contains all the definitions of the methods of
+ * AgendaScanner.hpp (see this file for methods' documentation)
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+#include "../include/AgendaScanner.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+//! Compare a name of the file with a string literal.
+template<size_t N>
+inline bool nameIs(const char* aName, size_t aLength, const char (&aLiteral)[N]) {
+	return aLength == N - 1 && memcmp(aName, aLiteral, N - 1) == 0;
+}
+
+inline bool isSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+//! Find a string in [aBegin, aEnd[, return aEnd if not found.
+inline const char* find(const char* aBegin, const char* aEnd, const char* aString, size_t aLength) {
+	const void* found = memmem(aBegin, aEnd - aBegin, aString, aLength);
+	return found == NULL ? aEnd : static_cast<const char*>(found);
+}
+
+//! Return the position following a string in [aBegin, aEnd[, aEnd if not found.
+inline const char* skip(const char* aBegin, const char* aEnd, const char* aString, size_t aLength) {
+	const char* found = find(aBegin, aEnd, aString, aLength);
+	return found == aEnd ? aEnd : found + aLength;
+}
+
+//! Parse a single character value, as lexical_cast<char>.
+inline bool parseChar(const char* aBegin, const char* aEnd, char& aValue) {
+	if( aEnd - aBegin != 1 ) return false;
+	aValue = *aBegin;
+	return true;
+}
+
+}
+
+
+AgendaScanner::AgendaScanner(const std::string& aFilename) :
+	_file(aFilename, true), _end(_file.data() + _file.size()) {
+}
+
+
+bool AgendaScanner::isSupported() const {
+
+	const char* data = _file.data();
+	if( data == NULL ) return false;
+
+	// UTF-16 and UTF-32 documents
+	if( (unsigned char)data[0] == 0xFE || (unsigned char)data[0] == 0xFF || data[0] == 0 ) return false;
+
+	// prolog, i.e. everything before the root element
+	const char* root = data;
+	while( (root = static_cast<const char*>(memchr(root, '<', _end - root))) != NULL
+			&& root + 1 < _end && (root[1] == '?' || root[1] == '!') ) {
+		root++;
+	}
+	if( root == NULL ) return false;
+
+	// ... ASCII-compatible encoding
+	const char* decl_end = find(data, root, "?>", 2);
+	const char* encoding = find(data, decl_end, "encoding", 8);
+	if( encoding != decl_end ) {
+		const char* quote = encoding + 8;
+		while( quote < decl_end && *quote != '"' && *quote != '\'' ) quote++;
+		string name;
+		for( const char* c = quote + 1; c < decl_end && *c != *quote; c++ ) name += tolower(*c);
+		if( name.compare(0, 5, "utf-8") != 0 && name.compare(0, 8, "us-ascii") != 0
+				&& name.compare(0, 8, "iso-8859") != 0 ) {
+			return false;
+		}
+	}
+
+	// ... no internal DTD subset
+	const char* doctype = find(data, root, "<!DOCTYPE", 9);
+	if( doctype != root && memchr(doctype, '[', find(doctype, root, ">", 1) - doctype) != NULL ) return false;
+
+	// (entities, character references and CDATA sections being found by the scan)
+	return true;
+
+}
+
+
+void AgendaScanner::scan(AgendaBuilder& aBuilder) const {
+
+	const char* p = _file.data();
+	while( p < _end ) {
+
+		const char* text = p;
+		p = static_cast<const char*>(memchr(p, '<', _end - p));
+		if( p == NULL ) break;
+		if( memchr(text, '&', p - text) != NULL ) error(text, "entity or character reference not supported");
+		const char* tag = p++;
+		if( p == _end ) error(tag, "unexpected end of file");
+
+		// processing instructions, comments and declarations
+		if( *p == '?' ) {
+			p = skip(p, _end, "?>", 2);
+			continue;
+		}
+		if( *p == '!' ) {
+			if( _end - p >= 8 && memcmp(p, "![CDATA[", 8) == 0 ) error(tag, "CDATA section not supported");
+			if( _end - p >= 3 && p[1] == '-' && p[2] == '-' ) p = skip(p, _end, "-->", 3);
+			else p = skip(p, _end, ">", 1);
+			continue;
+		}
+
+		// end tags
+		if( *p == '/' ) {
+			const char* name = ++p;
+			while( p < _end && *p != '>' && !isSpace(*p) ) p++;
+			if( nameIs(name, p - name, "person") ) aBuilder.endPerson();
+			p = skip(p, _end, ">", 1);
+			continue;
+		}
+
+		// start tags
+		const char* name = p;
+		while( p < _end && *p != '>' && *p != '/' && !isSpace(*p) ) p++;
+		size_t length = p - name;
+
+		if( nameIs(name, length, "person") ) {
+			p = scanPerson(p, aBuilder);
+			// the activities of a person out of the sample are skipped
+			if( aBuilder.isRejected() ) {
+				p = find(p, _end, "</person", 8);
+			}
+		}
+		else if( nameIs(name, length, "act") && aBuilder.wantsActivities() ) {
+			p = scanActivity(p, aBuilder);
+			// the rest of a rejected person is skipped
+			if( aBuilder.isRejected() ) {
+				p = find(p, _end, "</person", 8);
+			}
+		}
+		else {
+			const char* attr;
+			const char* value;
+			const char* value_end;
+			size_t attr_length;
+			bool empty;
+			while( nextAttribute(p, attr, attr_length, value, value_end, empty) ) {}
+		}
+
+	}
+
+}
+
+
+const char* AgendaScanner::scanPerson(const char* p, AgendaBuilder& aBuilder) const {
+
+	int id = 0;
+	int age_cl = 0;
+	char gender = 0;
+	char socio_pro_status = 0;
+	char edu_level = 0;
+
+	const char* name;
+	const char* value;
+	const char* value_end;
+	size_t length;
+	bool empty;
+	while( nextAttribute(p, name, length, value, value_end, empty) ) {
+
+		bool ok = true;
+		if( nameIs(name, length, "id") )              ok = parseInt(value, value_end, id);
+		else if( nameIs(name, length, "age_cl") )     ok = parseInt(value, value_end, age_cl);
+		else if( nameIs(name, length, "gender") )     ok = parseChar(value, value_end, gender);
+		else if( nameIs(name, length, "education") )  ok = parseChar(value, value_end, edu_level);
+		else if( nameIs(name, length, "sps_status") ) ok = parseChar(value, value_end, socio_pro_status);
+		if( !ok ) error(value, "invalid value of person attribute " + string(name, length));
+
+	}
+
+	aBuilder.beginPerson(id, age_cl, gender, socio_pro_status, edu_level);
+	if( empty ) aBuilder.endPerson();
+
+	return p;
+
+}
+
+
+const char* AgendaScanner::scanActivity(const char* p, AgendaBuilder& aBuilder) const {
+
+	char type = 0;
+	int node_id = -1; // -1 indicates that it is the last activity of the day, ie return to home
+	int duration = -1;
+	long end_time = -1;
+
+	const char* name;
+	const char* value;
+	const char* value_end;
+	size_t length;
+	bool empty;
+	while( nextAttribute(p, name, length, value, value_end, empty) ) {
+
+		bool ok = true;
+		if( nameIs(name, length, "type") )          ok = parseChar(value, value_end, type);
+		else if( nameIs(name, length, "end_time") ) ok = parseTime(value, value_end, end_time);
+		else if( nameIs(name, length, "duration") ) ok = parseFloorFloat(value, value_end, duration);
+		else if( nameIs(name, length, "node_id") )  ok = parseInt(value, value_end, node_id);
+		if( !ok ) error(value, "invalid value of act attribute " + string(name, length));
+
+	}
+
+	aBuilder.addActivity(type, node_id, end_time, duration);
+
+	return p;
+
+}
+
+
+bool AgendaScanner::nextAttribute(const char*& p, const char*& aName, size_t& aNameLength,
+		const char*& aValue, const char*& aValueEnd, bool& aEmpty) const {
+
+	while( p < _end && isSpace(*p) ) p++;
+	if( p == _end ) error(p, "unexpected end of file");
+
+	// end of the start tag
+	if( *p == '>' ) {
+		aEmpty = false;
+		p++;
+		return false;
+	}
+	if( *p == '/' ) {
+		if( p + 1 == _end || p[1] != '>' ) error(p, "malformed empty element");
+		aEmpty = true;
+		p += 2;
+		return false;
+	}
+
+	// name="value"
+	aName = p;
+	while( p < _end && *p != '=' && !isSpace(*p) ) p++;
+	aNameLength = p - aName;
+	while( p < _end && isSpace(*p) ) p++;
+	if( p == _end || *p != '=' ) error(p, "attribute without value");
+	p++;
+	while( p < _end && isSpace(*p) ) p++;
+	if( p == _end || (*p != '"' && *p != '\'') ) error(p, "unquoted attribute value");
+	aValue = p + 1;
+	aValueEnd = static_cast<const char*>(memchr(aValue, *p, _end - aValue));
+	if( aValueEnd == NULL ) error(p, "unterminated attribute value");
+	if( memchr(aValue, '&', aValueEnd - aValue) != NULL ) error(aValue, "entity or character reference not supported");
+	p = aValueEnd + 1;
+
+	return true;
+
+}
+
+
+void AgendaScanner::error(const char* p, const std::string& aMessage) const {
+	throw runtime_error("malformed agenda at byte " + to_string(p - _file.data()) + ": " + aMessage);
+}
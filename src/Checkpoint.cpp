@@ -0,0 +1,56 @@
+/****************************************************************
+ * CHECKPOINT.CPP
+ *
+ * This file contains all the definitions of the methods of
+ * Checkpoint.hpp (see this file for methods' documentation)
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+#include "../include/Checkpoint.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+using namespace std;
+
+
+std::string getCheckpointDir(const std::string& aDir, int aTick) {
+	return aDir + "/tick_" + to_string(aTick);
+}
+
+
+void writeCheckpointPart(const std::string& aDir, const CheckpointPart& aPart) {
+
+	string filename = aDir + "/process_" + to_string(aPart.rank) + ".bin";
+	ofstream out(filename.c_str(), ios::binary);
+	if( !out ) throw runtime_error("cannot create " + filename);
+	{
+		boost::archive::binary_oarchive archive(out);
+		archive << aPart;
+	}
+	out.close();
+	if( !out ) throw runtime_error("error while writing " + filename);
+
+}
+
+
+void readCheckpointPart(const std::string& aDir, int aRank, CheckpointPart& aPart) {
+
+	string filename = aDir + "/process_" + to_string(aRank) + ".bin";
+	ifstream in(filename.c_str(), ios::binary);
+	if( !in ) throw runtime_error("cannot open " + filename);
+	try {
+		boost::archive::binary_iarchive archive(in);
+		archive >> aPart;
+	}
+	catch(const boost::archive::archive_exception& ex) {
+		throw runtime_error(filename + " is not a valid checkpoint part (" + ex.what() + ")");
+	}
+	if( aPart.version != CHECKPOINT_VERSION || aPart.rank != aRank ) {
+		throw runtime_error(filename + " is not a valid checkpoint part");
+	}
+
+}
@@ -9,10 +9,117 @@
  ****************************************************************/
 
 #include "../include/Data.hpp"
+#include "../include/InputStream.hpp"
+#include "../include/Profiler.hpp"
+
+#include <fstream>
+#include <cstring>
+#include <climits>
+#include <libxml++/libxml++.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include <boost/filesystem.hpp>
+#include <boost/mpi/collectives.hpp>
 
 using namespace std;
 using namespace repast;
-using namespace tinyxml2;
+
+namespace fs = boost::filesystem;
+
+
+////////////////////
+// Node ids cache //
+////////////////////
+
+namespace {
+
+const char NODES_CACHE_MAGIC[8] = { 'V', 'B', 'N', 'O', 'D', 'E', 'S', 0 };  //!< magic number of a network cache file
+
+//! SAX parser collecting the ids of the nodes of a MATSim network.
+class NetworkSaxParser : public xmlpp::SaxParser {
+
+private:
+	vector<int>& _ids;
+	bool         _done;
+
+public:
+	NetworkSaxParser(vector<int>& aIds) : xmlpp::SaxParser(), _ids(aIds), _done(false) {}
+
+	//! True once the nodes element is closed, the links do not need to be parsed.
+	bool isDone() const {
+		return _done;
+	}
+
+protected:
+	virtual void on_start_element(const Glib::ustring& name, const AttributeList& attributes) {
+		if( name.compare("node") == 0 ) {
+			for( auto iter = attributes.begin(); iter != attributes.end(); ++iter ) {
+				if( iter->name.raw().compare("id") == 0 ) {
+					_ids.push_back(boost::lexical_cast<int>(iter->value.raw()));
+					break;
+				}
+			}
+		}
+	}
+
+	virtual void on_end_element(const Glib::ustring& name) {
+		if( name.compare("nodes") == 0 ) _done = true;
+	}
+
+};
+
+//! Read the node ids cache of a network, return false if it is missing or older than the network.
+bool read_nodes_cache(const string& aNetworkFile, const string& aCacheFile, vector<int>& aIds) {
+
+	boost::system::error_code ec;
+	if( !fs::exists(aCacheFile, ec)
+			|| fs::last_write_time(aCacheFile, ec) < fs::last_write_time(aNetworkFile, ec) ) {
+		return false;
+	}
+
+	ifstream in(aCacheFile.c_str(), ios::binary);
+	char magic[sizeof(NODES_CACHE_MAGIC)];
+	uint64_t n_nodes = 0;
+	in.read(magic, sizeof(magic));
+	in.read(reinterpret_cast<char*>(&n_nodes), sizeof(n_nodes));
+	if( !in || memcmp(magic, NODES_CACHE_MAGIC, sizeof(magic)) != 0 ) {
+		return false;
+	}
+	aIds.resize(n_nodes);
+	in.read(reinterpret_cast<char*>(aIds.data()), n_nodes * sizeof(int));
+
+	return bool(in);
+
+}
+
+//! Write the node ids cache of a network (failures are only reported).
+/*!
+  The cache is written to a temporary file renamed once complete, so a
+  concurrent reader never sees a partial cache.
+ */
+void write_nodes_cache(const string& aCacheFile, const vector<int>& aIds) {
+
+	string tmp_file = aCacheFile + ".tmp";
+	ofstream out(tmp_file.c_str(), ios::binary);
+	uint64_t n_nodes = aIds.size();
+	out.write(NODES_CACHE_MAGIC, sizeof(NODES_CACHE_MAGIC));
+	out.write(reinterpret_cast<const char*>(&n_nodes), sizeof(n_nodes));
+	out.write(reinterpret_cast<const char*>(aIds.data()), n_nodes * sizeof(int));
+	out.close();
+
+	boost::system::error_code ec;
+	if( out ) fs::rename(tmp_file, aCacheFile, ec);
+	if( !out || ec ) {
+		cerr << "WARNING: cannot write the network cache " << aCacheFile << endl;
+		fs::remove(tmp_file, ec);
+	}
+
+}
+
+}
 
 
 ////////////////
@@ -26,57 +133,146 @@ void Data::read_network() {
 	int n_proc   = RepastProcess::instance()->worldSize();
 	int cur_proc = RepastProcess::instance()->rank();
 	
-	// Loading XML file containing the network data.
+	// Reading the nodes ids on process 0 only
+	StartupProfiler::instance().start("network_read");
 	string filename = this->_props.getProperty("file.network");
-	XMLDocument doc(filename.c_str());
-	doc.loadFile(filename.c_str());
-
-	// Parsing the node data
-	if (cur_proc == 0) cout << "... reading network from " << filename.c_str() << endl;
-	XMLElement * ele = doc.FirstChildElement("network")->FirstChildElement("nodes")->FirstChildElement("node");
-	const XMLAttribute * attr;
-
-	int i = 0; 	// Number of nodes	
-	while (ele) {
+	vector<int> orig_ids;
+	if (cur_proc == 0) {
 
-		// reading id
-		attr = ele->FirstAttribute();
-		int id = attr->IntValue();
-		this->_map_nodes_orig_id_new_id[id] = i;
-		this->_map_nodes_new_id_orig_id[i]  = id;
+		bool use_cache = this->_props.getProperty("network.cache") != "false";
+		string cache_file = filename + ".nodes";
 
-		// only add the nodes of the current process
-		//if ( i % n_proc == cur_proc ) {
-		//	Node currNode(i);
-		//	this->_network.addNode(currNode);
-		//}
+		if( use_cache && read_nodes_cache(filename, cache_file, orig_ids) ) {
+			cout << "... reading network nodes from " << cache_file << endl;
+		} else {
+			cout << "... reading network from " << filename.c_str() << endl;
+			orig_ids.clear();
+			// ... only a complete list of the nodes being cached, by the first process of the first group
+			// (see splitWorld), the processes 0 of the other groups reading the network at the same time
+			bool complete = read_network_node_ids(filename, orig_ids);
+			if( complete && use_cache && boost::mpi::communicator().rank() == 0 ) write_nodes_cache(cache_file, orig_ids);
+		}
 
-		ele = ele->NextSiblingElement("node");
-		i++;
 	}
 
-	int n_nodes = i + 1 + (n_proc - (i + 1) % n_proc);
+	// ... and sharing them with every process
+	StartupProfiler::instance().start("network_broadcast");
+	boost::mpi::broadcast(*RepastProcess::instance()->getCommunicator(), orig_ids, 0);
+	this->_map_nodes_ids = NodeIdMap(orig_ids);
+
+	int i = orig_ids.size(); // Number of nodes
 
 	if ( cur_proc == 0 ) cout << "INFO: DATA GENERATION: Nodes read " << i << endl;
 
 	// saving the nodes necessary for the current process only
-	int k = cur_proc * (n_nodes / n_proc);  // lower node id handled by current process
-	int l = 0;                        // upper node id handled by current process
-	if (cur_proc < n_proc - 1) {
-	  l = (cur_proc + 1) * (n_nodes / n_proc) - 1;
-	} else {
-	  l = i - 1;
-	}
+	int k = 0;  // lower node id handled by current process
+	int l = 0;  // upper node id handled by current process
+	getNodesRange(i, n_proc, cur_proc, k, l);
 	for (int j = k; j <= l; j++) {
 	  Node currNode(j);
 	  this->_network.addNode(currNode);
 	}
 	
+	StartupProfiler::instance().stop();
 	if (cur_proc == 0) cout << "... done! " << endl;
 
 }
 
 
+void Data::getNodesRange(int aNNodes, int aNProc, int aProc, int& aFirst, int& aLast) {
+
+	int n_nodes = aNNodes + 1 + (aNProc - (aNNodes + 1) % aNProc);
+	aFirst = aProc * (n_nodes / aNProc);
+	if (aProc < aNProc - 1) {
+	  aLast = (aProc + 1) * (n_nodes / aNProc) - 1;
+	} else {
+	  aLast = aNNodes - 1;
+	}
+
+}
+
+
+int Data::getNodeProcess(int aNodeId, int aNNodes, int aNProc) {
+
+	int n_nodes = aNNodes + 1 + (aNProc - (aNNodes + 1) % aNProc);
+	return min(aNodeId / (n_nodes / aNProc), aNProc - 1);
+
+}
+
+
+bool Data::read_network_node_ids(const std::string& aFilename, std::vector<int>& aOrigIds) {
+
+	// streaming the (possibly compressed) file, stopping at the end of the nodes
+	NetworkSaxParser parser(aOrigIds);
+	try {
+		InputStream in(aFilename);
+		const char* data;
+		size_t size;
+		while( !parser.isDone() && (size = in.read(data)) > 0 ) {
+			parser.parse_chunk_raw(reinterpret_cast<const unsigned char*>(data), size);
+		}
+		if( !parser.isDone() ) parser.finish_chunk_parsing();
+	}
+	catch(const xmlpp::exception& ex) {
+		cerr << "libxml++ exception: " << ex.what() << endl;
+		return false;
+	}
+	catch(const std::exception& ex) {
+		cerr << "ERROR: cannot read network file " << aFilename << ": " << ex.what() << endl;
+		return false;
+	}
+
+	return parser.isDone();
+
+}
+
+
+//////////////////
+// Node ids map //
+//////////////////
+
+
+NodeIdMap::NodeIdMap(const std::vector<int>& aOrigIds) : _orig_to_new(), _new_to_orig(aOrigIds) {
+
+	_orig_to_new.reserve(aOrigIds.size());
+	for( size_t i = 0; i < aOrigIds.size(); i++ ) {
+		_orig_to_new.push_back(make_pair(aOrigIds[i], (int)i));
+	}
+	sort(_orig_to_new.begin(), _orig_to_new.end());
+
+	// a node appearing twice keeps its last position, as with the former std::map
+	auto last = _orig_to_new.begin();
+	for( auto it = _orig_to_new.begin(); it != _orig_to_new.end(); ++it ) {
+		if( it != _orig_to_new.begin() && it->first == last->first ) {
+			*last = *it;
+		} else if( it != _orig_to_new.begin() ) {
+			*(++last) = *it;
+		}
+	}
+	if( !_orig_to_new.empty() ) _orig_to_new.erase(last + 1, _orig_to_new.end());
+
+}
+
+
+int NodeIdMap::at(int aOrigId) const {
+
+	auto it = lower_bound(_orig_to_new.begin(), _orig_to_new.end(), make_pair(aOrigId, INT_MIN));
+	if( it == _orig_to_new.end() || it->first != aOrigId ) {
+		throw std::out_of_range("unknown node " + to_string(aOrigId));
+	}
+	return it->second;
+
+}
+
+
+size_t NodeIdMap::count(int aOrigId) const {
+
+	auto it = lower_bound(_orig_to_new.begin(), _orig_to_new.end(), make_pair(aOrigId, INT_MIN));
+	return (it != _orig_to_new.end() && it->first == aOrigId) ? 1 : 0;
+
+}
+
+
 /////////////////////////////////
 // Aggregate output data class //
 /////////////////////////////////
@@ -114,7 +310,65 @@ void AggregateSum::resetData() {
 
 long timeToSec(const std::string &aTime ) {
 
+	long seconds;
+	if( parseTime(aTime.data(), aTime.data() + aTime.size(), seconds) ) {
+		return seconds;
+	}
+
 	vector<long> time = split<long>(aTime, ":");
 	return time[0] * 3600 + time[1] * 60 + time[2];
 
 }
+
+
+MappedFile::MappedFile(const std::string& aFilename, bool aSequential) : _fd(-1), _size(0), _data(NULL) {
+
+	_fd = open(aFilename.c_str(), O_RDONLY);
+	if( _fd < 0 ) {
+		throw runtime_error("cannot open " + aFilename);
+	}
+
+	struct stat st;
+	fstat(_fd, &st);
+	_size = st.st_size;
+	if( _size == 0 ) {
+		return;
+	}
+
+	void* data = mmap(NULL, _size, PROT_READ, MAP_SHARED, _fd, 0);
+	if( data == MAP_FAILED ) {
+		close(_fd);
+		throw runtime_error("cannot map " + aFilename);
+	}
+	if( aSequential ) madvise(data, _size, MADV_SEQUENTIAL);
+	_data = static_cast<const char*>(data);
+
+}
+
+
+MappedFile::~MappedFile() {
+	if( _data != NULL ) munmap(const_cast<char*>(_data), _size);
+	close(_fd);
+}
+
+
+uint64_t getSampleSeed(const repast::Properties& aProps) {
+
+	string seed = aProps.getProperty(aProps.contains("sample.seed") ? "sample.seed" : "random.seed");
+	try {
+		return boost::lexical_cast<uint64_t>(seed);
+	}
+	catch(const boost::bad_lexical_cast&) {
+		return 0;
+	}
+
+}
+
+
+long getPeakMemory() {
+
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+
+}
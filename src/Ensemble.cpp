@@ -0,0 +1,52 @@
+/****************************************************************
+ * ENSEMBLE.CPP
+ *
+ * This file contains all the definitions of the methods of
+ * Ensemble.hpp (see this file for methods' documentation)
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+#include "../include/Ensemble.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+
+EnsembleCounts::EnsembleCounts(const std::string& aFilename, int aNReplicas, int aInterval, int aProc) :
+	_n_replicas(aNReplicas), _counts(5 * aNReplicas, 0), _n_individuals(0), _interval(aInterval), _proc(aProc), _out() {
+
+	if( _proc == 0 ) {
+		_out.open(aFilename.c_str());
+		if( !_out ) throw runtime_error("cannot create " + aFilename);
+		_out << "\"tick\";\"replica\";\"total_susceptible\";\"total_latent\";\"total_asymptomatic\";\"total_symptomatic\";\"total_recovered\"" << endl;
+	}
+
+}
+
+
+void EnsembleCounts::write(double aTick, const boost::mpi::communicator& aComm) {
+
+	// the individuals not counted in another state being susceptible
+	for( int r = 0; r < _n_replicas; r++ ) {
+		int* c = &_counts[5 * r];
+		c[0] = _n_individuals - c[1] - c[2] - c[3] - c[4];
+	}
+
+	// a single reduction of the counts of all the replicas
+	vector<int> counts(_proc == 0 ? _counts.size() : 0);
+	MPI_Reduce(_counts.data(), counts.data(), _counts.size(), MPI_INT, MPI_SUM, 0, aComm);
+	fill(_counts.begin(), _counts.end(), 0);
+	_n_individuals = 0;
+	if( _proc != 0 ) return;
+
+	// ... in the order of the columns of the aggregate output (the counts being in the order of state_inf)
+	for( int r = 0; r < _n_replicas; r++ ) {
+		const int* c = &counts[5 * r];
+		_out << aTick << ";" << r << ";" << c[0] << ";" << c[1] << ";" << c[3] << ";" << c[2] << ";" << c[4] << "\n";
+	}
+	_out.flush();
+
+}
@@ -38,7 +38,9 @@ IndividualPackage::IndividualPackage() :
 		socio_pro_status(),
 		edu_level(),
 		state(state_inf::SUSCEPTIBLE),
-		time_next_state() {
+		time_next_state(),
+		replicas(),
+		planes() {
 }
 
 IndividualPackage::IndividualPackage(int aId, int aInitProc, int aAgentType, int aCurProc, std::vector<Activity> aAgenda, int aCurAct, int aAgeCl,
@@ -54,7 +56,9 @@ IndividualPackage::IndividualPackage(int aId, int aInitProc, int aAgentType, int
 		socio_pro_status(aSocioProStatus),
 		edu_level(aEduLevel),
 		state(aState),
-		time_next_state(aTime) {
+		time_next_state(aTime),
+		replicas(),
+		planes() {
 }
 
 Individual::Individual(repast::AgentId id, std::vector<Activity> aAgenda, int aCurAct, int aAgeCl, char aGender, char aSocioProStatus,
@@ -118,6 +122,23 @@ std::ostream& operator<<(std::ostream& out, const Individual &ind) {
 
 }
 
+void Individual::setNReplicas(int aNReplicas) {
+
+	ReplicaState replica = { _state, _time_next_state };
+	_replicas.resize(aNReplicas - 1, replica);
+
+}
+
+void Individual::setPackedReplicas(int aNReplicas) {
+
+	ReplicaPlanes none = { 0, 0, 0 };
+	_planes.assign((aNReplicas + REPLICA_LANES - 1) / REPLICA_LANES, none);
+	for( int r = 0; r < aNReplicas; r++ ) {
+		_planes[r / REPLICA_LANES].set(r % REPLICA_LANES, _state);
+	}
+
+}
+
 void Individual::addActivity(const Activity& aActivity) {
 
 	_agenda.push_back(aActivity);
@@ -181,7 +202,7 @@ bool Individual::setNextAct() {
 	return false;
 }
 
-bool Individual::isLatent( float aInfectionProba ) {
+bool Individual::isLatent( float aInfectionProba, int aReplica ) {
 
 	float p = (float)Random::instance()->nextDouble();
 
@@ -189,8 +210,8 @@ bool Individual::isLatent( float aInfectionProba ) {
 	if( p < aInfectionProba ) {
 		// ... time before becoming infectious
 		double temp = Random::instance()->getGenerator("epsilon")->next() * 86400;
-		_time_next_state = (int)temp;
-		_state = state_inf::LATENT;
+		timeOf(aReplica) = (int)temp;
+		stateOf(aReplica) = state_inf::LATENT;
 		return true;
 	}
 
@@ -198,27 +219,28 @@ bool Individual::isLatent( float aInfectionProba ) {
 
 }
 
-void Individual::decreaseTimeTransition() {
+void Individual::decreaseTimeTransition( int aReplica ) {
 
-	if ( _time_next_state > 0 ) {
-		_time_next_state--;
+	int& time_next_state = timeOf(aReplica);
+	if ( time_next_state > 0 ) {
+		time_next_state--;
 	}
 
 }
 
-void Individual::determineInfectiousType( float aAsymptomicInfectiousProba ) {
+void Individual::determineInfectiousType( float aAsymptomicInfectiousProba, int aReplica ) {
 
 	// selection of the infection type: symptomic or asymptomatic
 	float p = (float)Random::instance()->nextDouble();
 	if( p < aAsymptomicInfectiousProba ) {
-		_state = state_inf::INFECTIOUS_ASYMPT;
+		stateOf(aReplica) = state_inf::INFECTIOUS_ASYMPT;
 	} else {
-		_state = state_inf::INFECTIOUS_SYMPT;
+		stateOf(aReplica) = state_inf::INFECTIOUS_SYMPT;
 	}
 
 	// time to recover
 	double temp = Random::instance()->getGenerator("mu")->next() * 86400;
-	_time_next_state  = (int)temp;
+	timeOf(aReplica) = (int)temp;
 
 
 }
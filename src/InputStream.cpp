@@ -0,0 +1,303 @@
+/****************************************************************
+ * INPUTSTREAM.CPP
+ *
+ * This file contains all the definitions of the methods of
+ * InputStream.hpp (see this file for methods' documentation)
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+#include "../include/InputStream.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <zlib.h>
+#include <libxml++/libxml++.h>
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace std;
+
+
+InputStream::InputStream(const std::string& aFilename, size_t aBufferSize, int aNBuffers) :
+	_filename(aFilename), _compression(detectCompression(aFilename)), _file(NULL),
+	_buffers(aNBuffers, vector<char>(aBufferSize)), _sizes(aNBuffers, 0), _free(), _full(),
+	_current(-1), _eof(false), _stop(false), _error() {
+
+	_file = fopen(aFilename.c_str(), "rb");
+	if( _file == NULL ) {
+		throw runtime_error("cannot open " + aFilename);
+	}
+
+	for( int i = 0; i < aNBuffers; i++ ) _free.push_back(i);
+	_producer = thread(&InputStream::produce, this);
+
+}
+
+
+InputStream::~InputStream() {
+
+	{
+		lock_guard<mutex> lock(_mutex);
+		_stop = true;
+	}
+	_cond_free.notify_all();
+	_producer.join();
+	fclose(_file);
+
+}
+
+
+size_t InputStream::read(const char*& aData) {
+
+	unique_lock<mutex> lock(_mutex);
+
+	// the previous chunk is given back to the producer
+	if( _current >= 0 ) {
+		_free.push_back(_current);
+		_current = -1;
+		_cond_free.notify_one();
+	}
+
+	_cond_full.wait(lock, [this] { return !_full.empty() || _eof; });
+	if( _full.empty() ) {
+		if( !_error.empty() ) throw runtime_error(_error);
+		return 0;
+	}
+
+	_current = _full.front();
+	_full.pop_front();
+	aData = &_buffers[_current][0];
+	return _sizes[_current];
+
+}
+
+
+Compression InputStream::detectCompression(const std::string& aFilename) {
+
+	unsigned char magic[4] = { 0, 0, 0, 0 };
+	FILE* f = fopen(aFilename.c_str(), "rb");
+	if( f == NULL ) return COMPRESSION_NONE;
+	size_t n_read = fread(magic, 1, sizeof(magic), f);
+	fclose(f);
+
+	if( n_read >= 2 && magic[0] == 0x1f && magic[1] == 0x8b ) return COMPRESSION_GZIP;
+	if( n_read == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd ) return COMPRESSION_ZSTD;
+	return COMPRESSION_NONE;
+
+}
+
+
+void InputStream::produce() {
+
+	try {
+		switch( _compression ) {
+		case COMPRESSION_GZIP : readGzip();  break;
+		case COMPRESSION_ZSTD : readZstd();  break;
+		default               : readPlain(); break;
+		}
+	}
+	catch(const std::exception& ex) {
+		lock_guard<mutex> lock(_mutex);
+		_error = ex.what();
+	}
+
+	{
+		lock_guard<mutex> lock(_mutex);
+		_eof = true;
+	}
+	_cond_full.notify_all();
+
+}
+
+
+int InputStream::acquireFree() {
+
+	unique_lock<mutex> lock(_mutex);
+	_cond_free.wait(lock, [this] { return !_free.empty() || _stop; });
+	if( _stop ) return -1;
+
+	int buffer = _free.front();
+	_free.pop_front();
+	return buffer;
+
+}
+
+
+void InputStream::releaseFull(int aBuffer, size_t aSize) {
+
+	{
+		lock_guard<mutex> lock(_mutex);
+		_sizes[aBuffer] = aSize;
+		_full.push_back(aBuffer);
+	}
+	_cond_full.notify_one();
+
+}
+
+
+void InputStream::readPlain() {
+
+	int buffer;
+	while( (buffer = acquireFree()) >= 0 ) {
+		size_t n_read = fread(&_buffers[buffer][0], 1, _buffers[buffer].size(), _file);
+		if( ferror(_file) ) throw runtime_error("error while reading " + _filename);
+		if( n_read == 0 ) break;
+		releaseFull(buffer, n_read);
+	}
+
+}
+
+
+void InputStream::readGzip() {
+
+	vector<unsigned char> in(1 << 18);
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	if( inflateInit2(&stream, 15 + 32) != Z_OK ) {
+		throw runtime_error("cannot initialize the gzip decompression of " + _filename);
+	}
+
+	bool end_of_input = false;
+	bool in_member = false;
+	bool finished = false;
+	int buffer;
+	string error;
+	while( !finished && error.empty() && (buffer = acquireFree()) >= 0 ) {
+
+		stream.next_out  = reinterpret_cast<unsigned char*>(&_buffers[buffer][0]);
+		stream.avail_out = _buffers[buffer].size();
+
+		while( stream.avail_out > 0 ) {
+
+			if( stream.avail_in == 0 && !end_of_input ) {
+				stream.next_in  = &in[0];
+				stream.avail_in = fread(&in[0], 1, in.size(), _file);
+				if( ferror(_file) ) {
+					error = "error while reading " + _filename;
+					break;
+				}
+				end_of_input = feof(_file);
+			}
+			if( stream.avail_in == 0 && !in_member ) {
+				finished = true;
+				break;
+			}
+
+			in_member = true;
+			unsigned int avail_out = stream.avail_out;
+			int status = inflate(&stream, Z_NO_FLUSH);
+			if( status == Z_STREAM_END ) {
+				// concatenated members are decompressed as a single stream
+				in_member = false;
+				inflateReset(&stream);
+			} else if( status != Z_OK && status != Z_BUF_ERROR ) {
+				error = "gzip error in " + _filename + (stream.msg != NULL ? string(": ") + stream.msg : string());
+				break;
+			} else if( stream.avail_in == 0 && end_of_input && stream.avail_out == avail_out ) {
+				error = _filename + " is truncated";
+				break;
+			}
+
+		}
+
+		size_t n_out = _buffers[buffer].size() - stream.avail_out;
+		if( n_out > 0 ) {
+			releaseFull(buffer, n_out);
+		} else {
+			lock_guard<mutex> lock(_mutex);
+			_free.push_back(buffer);
+		}
+
+	}
+
+	inflateEnd(&stream);
+	if( !error.empty() ) throw runtime_error(error);
+
+}
+
+
+#ifdef USE_ZSTD
+
+void InputStream::readZstd() {
+
+	vector<char> in(ZSTD_DStreamInSize());
+	ZSTD_DStream* stream = ZSTD_createDStream();
+	if( stream == NULL || ZSTD_isError(ZSTD_initDStream(stream)) ) {
+		throw runtime_error("cannot initialize the zstd decompression of " + _filename);
+	}
+
+	ZSTD_inBuffer input = { &in[0], 0, 0 };
+	bool end_of_input = false;
+	bool finished = false;
+	size_t status = 0;
+	int buffer;
+	string error;
+	while( !finished && error.empty() && (buffer = acquireFree()) >= 0 ) {
+
+		ZSTD_outBuffer output = { &_buffers[buffer][0], _buffers[buffer].size(), 0 };
+
+		while( output.pos < output.size ) {
+
+			if( input.pos == input.size && !end_of_input ) {
+				input.size = fread(&in[0], 1, in.size(), _file);
+				input.pos  = 0;
+				if( ferror(_file) ) {
+					error = "error while reading " + _filename;
+					break;
+				}
+				end_of_input = feof(_file);
+			}
+			// status is 0 only when a frame is complete and fully flushed
+			if( input.pos == input.size && status == 0 ) {
+				finished = true;
+				break;
+			}
+
+			size_t output_pos = output.pos;
+			status = ZSTD_decompressStream(stream, &output, &input);
+			if( ZSTD_isError(status) ) {
+				error = "zstd error in " + _filename + ": " + ZSTD_getErrorName(status);
+				break;
+			} else if( input.pos == input.size && end_of_input && output.pos == output_pos && status != 0 ) {
+				error = _filename + " is truncated";
+				break;
+			}
+
+		}
+
+		if( output.pos > 0 ) {
+			releaseFull(buffer, output.pos);
+		} else {
+			lock_guard<mutex> lock(_mutex);
+			_free.push_back(buffer);
+		}
+
+	}
+
+	ZSTD_freeDStream(stream);
+	if( !error.empty() ) throw runtime_error(error);
+
+}
+
+#else
+
+void InputStream::readZstd() {
+	throw runtime_error(_filename + " is zstd compressed, build with USE_ZSTD=1 to read it");
+}
+
+#endif
+
+
+void parseXmlFile(const std::string& aFilename, xmlpp::SaxParser& aParser) {
+
+	InputStream in(aFilename);
+	const char* data;
+	size_t size;
+	while( (size = in.read(data)) > 0 ) {
+		aParser.parse_chunk_raw(reinterpret_cast<const unsigned char*>(data), size);
+	}
+	aParser.finish_chunk_parsing();
+
+}
@@ -13,7 +13,10 @@
 using namespace repast;
 using namespace std;
 
-Model::Model( boost::mpi::communicator* world, Properties & props ) : _props(props) {
+Model::Model( boost::mpi::communicator* world, Properties & props ) : _props(props), _data_collection(NULL), _node_series(NULL),
+		_node_series_interval(0), _first_node(0), _transmissions(NULL), _strata(NULL), _n_replicas(1), _packed(false), _lanes(), _active_replicas(), _local_active(), _extinction_interval(0), _n_active_local(0), _ensemble(NULL), _time_of_day(0), _days_simulated(0),
+		_start_tick(0), _checkpoint_interval(0), _checkpoint_dir(), _snapshot(), _snapshot_time_of_day(0), _snapshot_days_simulated(0),
+		_n_nodes_network(0), _n_proc(1) {
 
 	// Reading properties, rank of the process and input filenames ----
 
@@ -25,19 +28,19 @@ Model::Model( boost::mpi::communicator* world, Properties & props ) : _props(pro
 	// getting the network
 	_network = Data::getInstance()->getNetwork();
 
-	// dumping nodes in a file
-	_network.dumpNodes(_proc);
+	// dumping nodes in a file, per group of processes (see splitWorld)
+	string group = _props.getProperty("process.group");
+	_network.dumpNodes((group.empty() ? "" : "_group_" + group + "_") + to_string(_proc));
 
-	// process nodes recording
-	for( auto n : _network.getNodes() ) {
-		_map_node_process[n.first] = _proc;
-	}
-	constructMapNodeProcess();
+	// the process of a node being given by the nodes partition, without a map of the whole network
+	_n_nodes_network = Data::getInstance()->getMapNodesOrigIdNewId().size();
+	_n_proc = world->size();
 
 	// Spatial projection construction --------------------------------
 
-	int n_nodes = _map_node_process.size();
-	int n_proc = world->size();
+	StartupProfiler::instance().start("space_setup");
+	int n_nodes = _n_nodes_network;
+	int n_proc = _n_proc;
 	n_nodes = n_nodes + 1 + (n_proc - (n_nodes + 1) % n_proc);
 	if (_proc == 0 ) {
 		cout << "INFO: MODEL CONSTRUCTOR: total number of nodes: " << n_nodes << endl;
@@ -55,6 +58,7 @@ Model::Model( boost::mpi::communicator* world, Properties & props ) : _props(pro
 	_agents->addProjection(_discrete_space);
 
 	 _moore2DQuery = new Moore2DGridQuery<Individual>(_discrete_space);
+	StartupProfiler::instance().stop();
 	
 	// querry method applied on the discrete space
 	// todo: move to definition of Spatial Projection
@@ -65,7 +69,88 @@ Model::Model( boost::mpi::communicator* world, Properties & props ) : _props(pro
 
 	cout << "INFO: Proc " << _proc << ": Dimensions: " << _discrete_space->dimensions() << endl;
 
-	// Model parameters -----------------------------------------------
+	// Model parameters and random generators ------------------------
+
+	initParameters();
+
+	// Initialization of the agents -----------------------------------
+
+	// ... with a disease state per replica of the ensemble
+	if( _props.contains("ensemble.replicas") ) _n_replicas = max(repast::strToInt(_props.getProperty("ensemble.replicas")), 1);
+	_packed = _n_replicas > 1 && _props.getProperty("ensemble.packed") == "true";
+	for( int r = 0; r < _n_replicas; r += REPLICA_LANES ) {
+		int n_lanes = min(_n_replicas - r, REPLICA_LANES);
+		_lanes.push_back(n_lanes == REPLICA_LANES ? ~(uint64_t)0 : ((uint64_t)1 << n_lanes) - 1);
+	}
+
+	string restart_dir = _props.getProperty("restart.from");
+	if( !restart_dir.empty() ) {
+
+		// ... from a checkpoint
+		StartupProfiler::instance().start("checkpoint_restore");
+		try {
+			restoreCheckpoint(restart_dir);
+		}
+		catch(const std::exception& ex) {
+			cerr << "ERROR: Proc " << _proc << ": " << ex.what() << endl;
+			MPI_Abort(*world, EXIT_FAILURE);
+		}
+		StartupProfiler::instance().stop();
+		cout << "INFO: Proc " << _proc << ": Number of agents: " << _agents->size() << endl;
+
+	} else {
+
+		init_agents_sax();
+		cout << "INFO: Proc " << _proc << ": Number of agents: " << _agents->size() << endl;
+
+	}
+
+	if( _n_replicas > 1 ) {
+		for( auto it = _agents->localBegin(); it != _agents->localEnd(); it++ ) {
+			if( _packed ) {
+				if( (*it)->getPlanes().empty() ) (*it)->setPackedReplicas(_n_replicas);
+			}
+			else          (*it)->setNReplicas(_n_replicas);
+		}
+		if( _proc == 0 ) cout << "... ensemble of " << _n_replicas << " replicas" << (_packed ? " (packed)" : "") << endl;
+	}
+
+	// ... the scenarios all start from the agents initialized so far (see startScenario)
+	if( !_props.getProperty("scenarios.file").empty() ) {
+		StartupProfiler::instance().start("snapshot");
+		takeSnapshot();
+		StartupProfiler::instance().stop();
+		if ( _proc == 0 ) cout << "... end of model initialization!" << endl;
+		return;
+	}
+
+	// Init agents sick
+	if( restart_dir.empty() ) {
+		StartupProfiler::instance().start("infection_seeding");
+		initInfectAgents();
+		StartupProfiler::instance().stop();
+	}
+
+	// Outputs --------------------------------------------------------
+
+	StartupProfiler::instance().start("dataset_setup");
+	initOutputs("../output/");
+	StartupProfiler::instance().stop();
+
+	if ( _proc == 0 ) cout << "... end of model initialization!" << endl;
+
+}
+
+
+Model::~Model() {        
+	delete _agents;
+	delete _moore2DQuery;
+	closeOutputs();
+	// delete the random generators + querry?
+}
+
+
+void Model::initParameters() {
 
 	_r_beta  = boost::lexical_cast<float>(_props.getProperty("r.beta"));
 	_beta    = boost::lexical_cast<float>(_props.getProperty("beta"));
@@ -76,28 +161,44 @@ Model::Model( boost::mpi::communicator* world, Properties & props ) : _props(pro
 
 	_time_step = boost::lexical_cast<float>(_props.getProperty("time.step"));
 	_sample_size = boost::lexical_cast<float>(_props.getProperty("sample.size"));
-	
+	_sample_seed = ::getSampleSeed(_props);
+
 	_r_beta_x_beta = _r_beta * _beta;
 
-	// Random generators --------------------------------------------
+	_extinction_interval = 0;
+	if( _props.contains("extinction.interval") ) _extinction_interval = repast::strToInt(_props.getProperty("extinction.interval"));
+
+	// per tick draws of the packed replicas, the exponential durations being memoryless
+	_draw_latent_end     = LaneBernoulli(-expm1(-_epsilon / 86400.0));
+	_draw_recovery       = LaneBernoulli(-expm1(-_mu / 86400.0));
+	_draw_asympt         = LaneBernoulli(_p_a);
+	_draw_infect_sympt   = LaneBernoulli(_beta);
+	_draw_infect_asympt  = LaneBernoulli(_r_beta_x_beta);
 
-	initializeRandom(props, world);
+	// random generators, initialized again for every scenario (the generators being lost)
+	initializeRandom(_props, RepastProcess::instance()->getCommunicator());
 	ExponentialGenerator* rnd_epsilon_inv = new ExponentialGenerator(Random::instance()->createExponentialGenerator(_epsilon));
 	Random::instance()->putGenerator("epsilon",rnd_epsilon_inv);
 	ExponentialGenerator* rnd_mu_inv = new ExponentialGenerator(Random::instance()->createExponentialGenerator(_mu));
 	Random::instance()->putGenerator("mu",rnd_mu_inv);
 
-	// Initialization of the agents -----------------------------------
+}
 
-	init_agents_sax();
-	cout << "INFO: Proc " << _proc << ": Number of agents: " << _agents->size() << endl;
 
-	// Init agents sick
-	initInfectAgents();
+void Model::initOutputs(const std::string& aOutputDir) {
+
+	boost::mpi::communicator* world = RepastProcess::instance()->getCommunicator();
+	int n_proc = world->size();
+	if( _proc == 0 ) boost::filesystem::create_directories(aOutputDir);
+	world->barrier();
+
+	// a run restarted from a checkpoint writes its outputs to new files (<name>_<start tick>), keeping those of the
+	// checkpointed run
+	string restart = _start_tick > 0 ? "_" + to_string(_start_tick) : "";
 
 	// Aggregate data output ------------------------------------------
 
-	string fileOutputName("../output/sim_out.csv");
+	string fileOutputName(aOutputDir + "sim_out.csv");
 	SVDataSetBuilder builder( fileOutputName.c_str(), ";", RepastProcess::instance()->getScheduleRunner().schedule() );
 	builder.addDataSource(repast::createSVDataSource("total_susceptible", &this->_total_susceptible, std::plus<int>()));
 	builder.addDataSource(repast::createSVDataSource("total_latent", &this->_total_latent, std::plus<int>()));
@@ -105,30 +206,501 @@ Model::Model( boost::mpi::communicator* world, Properties & props ) : _props(pro
 	builder.addDataSource(repast::createSVDataSource("total_symptomatic", &this->_total_infectious_sympt, std::plus<int>()));
 	builder.addDataSource(repast::createSVDataSource("total_recovered", &this->_total_recovered, std::plus<int>()));
 	builder.addDataSource(repast::createSVDataSource("total_nodes_infected", &this->_total_nodes_infected, std::plus<int>()));
+
+	// one row every output.record.interval ticks, optionally with the min/max/mean over the interval
+	int record_interval = 1;
+	if( _props.contains("output.record.interval") ) record_interval = repast::strToInt(_props.getProperty("output.record.interval"));
+	builder.setRecordInterval(record_interval, _props.getProperty("output.record.stats") == "true");
+	builder.setNonBlocking(_props.getProperty("output.nonblocking") == "true");
 	this->_data_collection = builder.createDataSet();
 
-	if ( _proc == 0 ) cout << "... end of model initialization!" << endl;
+	// checkpoints, every checkpoint.interval ticks (a multiple of output.record.interval, so no row is pending)
+	_checkpoint_interval = 0;
+	if( _props.contains("checkpoint.interval") ) _checkpoint_interval = repast::strToInt(_props.getProperty("checkpoint.interval"));
+	if( _checkpoint_interval > 0 ) {
+		_checkpoint_dir = _props.contains("checkpoint.dir") ? _props.getProperty("checkpoint.dir") : aOutputDir + "checkpoints";
+		if( _checkpoint_interval % record_interval != 0 ) {
+			_checkpoint_interval = (_checkpoint_interval / record_interval + 1) * record_interval;
+			if( _proc == 0 ) cout << "WARNING: checkpoint.interval rounded to " << _checkpoint_interval
+					<< ", a multiple of output.record.interval" << endl;
+		}
+	}
+
+	// per node output, each process writing its own nodes every output.nodes.interval ticks
+	_node_series_interval = 0;
+	if( _props.contains("output.nodes.interval") ) _node_series_interval = repast::strToInt(_props.getProperty("output.nodes.interval"));
+	if( _node_series_interval > 0 ) {
+		int n_nodes_network = Data::getInstance()->getMapNodesOrigIdNewId().size();
+		int last_node;
+		Data::getNodesRange(n_nodes_network, n_proc, _proc, _first_node, last_node);
+		vector<string> columns = { "infectious", "latent" };
+		try {
+			_node_series = new NodeSeriesWriter(aOutputDir + "sim_nodes" + restart + ".bin", *world, columns, n_nodes_network, _first_node,
+					last_node, _node_series_interval);
+			_node_values.resize(columns.size() * max(last_node - _first_node + 1, 0));
+		}
+		catch(const std::exception& ex) {
+			cerr << "ERROR: Proc " << _proc << ": " << ex.what() << endl;
+		}
+	}
+
+	// the outputs reduced on the process 0 (the only one opening their file) being kept on every process or on none
+	auto createdEverywhere = [&](bool aCreated) {
+		int created = aCreated ? 1 : 0;
+		int all_created = 0;
+		boost::mpi::all_reduce(*world, created, all_created, boost::mpi::minimum<int>());
+		return all_created == 1;
+	};
+
+	// counts per state and stratum, written with the aggregate output rows
+	string strata = _props.getProperty("output.strata");
+	if( !strata.empty() && strata != "none" ) {
+		try {
+			_strata = new StrataCounts(_props, aOutputDir + "sim_strata" + restart + ".csv", record_interval, _proc);
+		}
+		catch(const std::exception& ex) {
+			cerr << "ERROR: Proc " << _proc << ": " << ex.what() << endl;
+		}
+		if( createdEverywhere(_strata != NULL) ) {
+			_strata->init(_agents->localBegin(), _agents->localEnd(), *world);
+		} else {
+			delete _strata;
+			_strata = NULL;
+		}
+	}
+
+	// counts of every replica of the ensemble, with the aggregate output rows
+	if( _n_replicas > 1 ) {
+		try {
+			_ensemble = new EnsembleCounts(aOutputDir + "sim_ensemble" + restart + ".csv", _n_replicas, record_interval, _proc);
+		}
+		catch(const std::exception& ex) {
+			cerr << "ERROR: Proc " << _proc << ": " << ex.what() << endl;
+		}
+		if( !createdEverywhere(_ensemble != NULL) ) {
+			delete _ensemble;
+			_ensemble = NULL;
+		}
+	}
+
+	// transmission events, merged after the simulation with the merge_transmissions tool
+	if( _props.getProperty("output.transmissions") == "true" ) {
+		try {
+			_transmissions = new TransmissionLog(aOutputDir + "transmissions_" + to_string(_proc) + restart + ".bin", _proc, n_proc);
+		}
+		catch(const std::exception& ex) {
+			cerr << "ERROR: Proc " << _proc << ": " << ex.what() << endl;
+		}
+	}
 
 }
 
 
-Model::~Model() {        
-	delete _agents;
-	delete _moore2DQuery;
-	// delete the random generators + querry?
+void Model::closeOutputs() {
+
+	delete _data_collection;
+	_data_collection = NULL;
+	delete _node_series;
+	_node_series = NULL;
+	delete _strata;
+	_strata = NULL;
+	delete _ensemble;
+	_ensemble = NULL;
+	if( _transmissions != NULL ) {
+		cout << "INFO: Proc " << _proc << ": " << _transmissions->getNRecords() << " transmission events written" << endl;
+		delete _transmissions;
+		_transmissions = NULL;
+	}
+
+}
+
+
+void Model::takeSnapshot() {
+
+	fillCheckpointPart(_snapshot);
+	_snapshot_time_of_day    = _time_of_day;
+	_snapshot_days_simulated = _days_simulated;
+	cout << "INFO: Proc " << _proc << ": snapshot of " << _snapshot.agents.size() << " agents" << endl;
+
+}
+
+
+void Model::removeLocalAgents() {
+
+	vector<AgentId> ids;
+	for( auto it = _agents->localBegin(); it != _agents->localEnd(); it++ ) ids.push_back((*it)->getId());
+	for( const auto& id : ids ) _agents->removeAgent(id);
+
+}
+
+
+void Model::restoreSnapshot() {
+
+	// agents of the previous scenario, wherever they come from
+	removeLocalAgents();
+	_map_agents_to_move_process.clear();
+
+	map<int, Node> nodes = _network.getNodes();
+	for( auto& n : nodes ) n.second.setInfected(0);
+
+	// ... replaced by the ones of the snapshot, restored on a copy of it
+	CheckpointPart part = _snapshot;
+	restoreCheckpointPart(part, true, nodes);
+
+	long n_infected_nodes = 0;
+	for( const auto& n : nodes ) {
+		if( n.second.getInfected() > 0 ) n_infected_nodes++;
+	}
+	_network.setNodes(nodes);
+	_network.setNInfectedNodes(n_infected_nodes);
+
+	_time_of_day    = _snapshot_time_of_day;
+	_days_simulated = _snapshot_days_simulated;
+
+}
+
+
+void Model::startScenario(const std::string& aName) {
+
+	initParameters();
+	restoreSnapshot();
+
+	// a snapshot of a checkpoint already has its infected agents
+	if( _start_tick == 0 ) initInfectAgents();
+
+	// ... the checkpoints of the scenarios in distinct directories
+	initOutputs("../output/" + aName + "/");
+	if( _props.contains("checkpoint.dir") ) _checkpoint_dir += "/" + aName;
+
+}
+
+
+void Model::endScenario() {
+	closeOutputs();
 }
 
 
 void Model::init_agents_sax() {
 
-	VBSaxParser parser(_proc, *this);
+	StartupProfiler::instance().start("agents_parse");
 	string input_xml_file = this->_props.getProperty("file.agenda");
+
+	// sharded population read without every process opening the file (see population.io), the process 0 checking
+	// that it is a binary population
+	string population_io = _props.getProperty("population.io");
+	bool sharded_io = population_io == "mpiio" || population_io == "scatter";
+	bool binary = false;
+	if( sharded_io ) {
+		if( _proc == 0 ) binary = PopulationFile::isPopulationFile(input_xml_file);
+		boost::mpi::broadcast(*RepastProcess::instance()->getCommunicator(), binary, 0);
+		if( !binary && _proc == 0 ) cout << "WARNING: " << input_xml_file << " is not a binary population, ignoring population.io = "
+				<< population_io << endl;
+	}
+	else {
+		binary = PopulationFile::isPopulationFile(input_xml_file);
+	}
+
+	// preprocessed population (see the agenda2bin tool), sharded or not
+	if( binary ) {
+		int failed = 0;
+		try {
+			if( !sharded_io ) {
+				init_agents_bin(input_xml_file);
+			}
+			else if( !init_agents_shard(input_xml_file, population_io == "mpiio") ) {
+				if( _proc == 0 ) cout << "WARNING: " << input_xml_file << " is not sharded for " << RepastProcess::instance()->worldSize()
+						<< " processes, using population.io = mmap" << endl;
+				init_agents_bin(input_xml_file);
+			}
+		}
+		catch(const std::exception& ex) {
+			cerr << "ERROR: Proc " << _proc << ": " << ex.what() << endl;
+			failed = 1;
+		}
+
+		// ... a population that cannot be read being fatal on every process, rather than a run without its agents
+		int any_failed = 0;
+		boost::mpi::all_reduce(*RepastProcess::instance()->getCommunicator(), failed, any_failed, boost::mpi::maximum<int>());
+		if( any_failed == 1 ) {
+			if( _proc == 0 ) cerr << "ERROR: Proc " << _proc << ": cannot read the population " << input_xml_file << endl;
+			MPI_Abort(*RepastProcess::instance()->getCommunicator(), EXIT_FAILURE);
+		}
+	}
+	else {
+
+		// specialized scanner, unless the agenda uses constructs only handled by libxml++
+		bool use_scanner = false;
+		long n_persons = 0, n_kept = 0;
+		if( _props.getProperty("agenda.parser") != "libxml"
+				&& InputStream::detectCompression(input_xml_file) == COMPRESSION_NONE ) {
+			try {
+				AgendaScanner scanner(input_xml_file);
+				use_scanner = scanner.isSupported();
+				if( use_scanner ) {
+					AgendaBuilder builder(_proc, *this);
+					scanner.scan(builder);
+					n_persons = builder.getNPersons();
+					n_kept = builder.getNKept();
+				}
+			}
+			catch(const std::exception& ex) {
+				// ... the agenda being parsed again from the start by libxml++
+				cout << "WARNING: Proc " << _proc << ": " << ex.what() << ", parsing " << input_xml_file << " with libxml++" << endl;
+				removeLocalAgents();
+				use_scanner = false;
+			}
+		}
+
+		if( use_scanner == false ) {
+			VBSaxParser parser(_proc, *this);
+			try {
+				parser.set_substitute_entities(true);
+				parseXmlFile(input_xml_file, parser);
+			}
+			catch(const xmlpp::exception& ex) {
+				cerr << "libxml++ exception: " << ex.what() << endl;
+			}
+			catch(const std::exception& ex) {
+				cerr << "ERROR: Proc " << _proc << ": " << ex.what() << endl;
+			}
+			n_persons = parser.getBuilder().getNPersons();
+			n_kept = parser.getBuilder().getNKept();
+		}
+
+		cout << "INFO: Proc " << _proc << ": " << n_persons << " persons parsed, "
+				<< n_kept << " kept" << (use_scanner ? "" : " (libxml++)") << endl;
+
+	}
+
+	StartupProfiler::instance().stop();
+	cout << "INFO: Proc " << _proc << ": peak memory after agents initialization: " << getPeakMemory() / 1024 << " MB" << endl;
+
+}
+
+
+void Model::init_agents_bin(const std::string& aFilename) {
+
+	PopulationFile population(aFilename);
+	if( _proc == 0 ) cout << "... reading population from " << aFilename << " (" << population.getNPersons() << " persons)" << endl;
+	checkPopulation(population.getHeader(), aFilename);
+
+	// persons living on the nodes of the current process, in the order of the file (the xml order, grouped by
+	// shard for a sharded file)
+	vector<uint32_t> local_persons;
+	for( auto n : _network.getNodes() ) {
+		const uint32_t* begin;
+		const uint32_t* end;
+		population.getPersonsAtNode(n.first, begin, end);
+		local_persons.insert(local_persons.end(), begin, end);
+	}
+	sort(local_persons.begin(), local_persons.end());
+
+	for( auto p : local_persons ) {
+		const PersonRecord& person = population.getPerson(p);
+		addPopulationAgent(person, population.getActivities(person));
+	}
+
+}
+
+
+bool Model::init_agents_shard(const std::string& aFilename, bool aCollective) {
+
+	PopulationShard shard;
+	MPI_Comm comm = *RepastProcess::instance()->getCommunicator();
+	bool sharded = aCollective ? readPopulationShard(aFilename, comm, shard) : scatterPopulationShards(aFilename, comm, shard);
+	if( !sharded ) return false;
+
+	if( _proc == 0 ) cout << "... reading population shards from " << aFilename << " (" << shard.header.n_persons << " persons)" << endl;
+	checkPopulation(shard.header, aFilename);
+
+	for( const auto& person : shard.persons ) {
+		if( person.home_node < 0 ) continue;
+		if( getNodeProcess(person.home_node) != _proc ) {
+			throw std::runtime_error(aFilename + " was not sharded with the nodes partition of the simulation");
+		}
+		addPopulationAgent(person, shard.activities.data() + person.first_activity);
+	}
+
+	return true;
+
+}
+
+
+void Model::checkPopulation(const PopulationHeader& aHeader, const std::string& aFilename) const {
+
+	if( aHeader.n_nodes != Data::getInstance()->getMapNodesOrigIdNewId().size() ) {
+		throw std::runtime_error(aFilename + " was not converted with the network " + _props.getProperty("file.network"));
+	}
+
+	// a pre-sampled population can only be sampled further with the same seed
+	if( aHeader.sample_size < 1.0 && (aHeader.sample_seed != _sample_seed || aHeader.sample_size < _sample_size) ) {
+		throw std::runtime_error(aFilename + " was sampled with sample.size = " + to_string(aHeader.sample_size)
+				+ " and seed " + to_string(aHeader.sample_seed) + ", incompatible with the model properties");
+	}
+
+}
+
+
+void Model::addPopulationAgent(const PersonRecord& aPerson, const ActivityRecord* aActivities) {
+
+	// keeping only a proportion of the agents defined by the sample.size input parameter
+	if( !isSampled(aPerson.id, _sample_size, _sample_seed) ) return;
+
+	vector<Activity> agenda;
+	agenda.reserve(aPerson.n_activities);
+	for( uint32_t a = 0; a < aPerson.n_activities; a++ ) {
+		agenda.push_back(Activity(aActivities[a].node_id, aActivities[a].start_time, aActivities[a].end_time, aActivities[a].type));
+	}
+
+	AgentId repast_id(aPerson.id, _proc, MODEL_AGENT_IND_TYPE, _proc);
+	Individual* ind = new Individual(repast_id, agenda, 0, aPerson.age_cl, aPerson.gender,
+			aPerson.socio_pro_status, aPerson.edu_level, state_inf::SUSCEPTIBLE, 0);
+	auto insertion_start = StartupProfiler::now();
+	addAgent(ind);
+	moveAgentToNode(repast_id, aPerson.home_node);
+	StartupProfiler::instance().addNested("agents_insertion", insertion_start);
+
+}
+
+
+void Model::writeCheckpoint(int aTick) {
+
+	boost::mpi::communicator* comm = RepastProcess::instance()->getCommunicator();
+	string dir = getCheckpointDir(_checkpoint_dir, aTick);
+	if( _proc == 0 ) boost::filesystem::create_directories(dir);
+	comm->barrier();
+
+	// the rows up to the tick are written to the aggregate output
+	_data_collection->write();
+	_data_collection->flush();
+
+	CheckpointPart part;
+	fillCheckpointPart(part);
+
+	int written = 1;
 	try {
-	        parser.set_substitute_entities(true);
-	        parser.parse_file(input_xml_file);
+		writeCheckpointPart(dir, part);
+	}
+	catch(const std::exception& ex) {
+		cerr << "ERROR: Proc " << _proc << ": " << ex.what() << endl;
+		written = 0;
+	}
+
+	// ... the checkpoint is complete once the global state is written
+	int all_written = 0;
+	boost::mpi::all_reduce(*comm, written, all_written, boost::mpi::minimum<int>());
+	if( _proc == 0 && all_written == 1 ) {
+		ofstream out((dir + "/checkpoint.props").c_str());
+		out << "tick = " << aTick << endl;
+		out << "process.count = " << comm->size() << endl;
+		out << "time_of_day = " << _time_of_day << endl;
+		out << "days_simulated = " << _days_simulated << endl;
+		out.close();
+		if( out ) cout << "INFO: Proc " << _proc << ": checkpoint written to " << dir << endl;
+		else      cerr << "ERROR: Proc " << _proc << ": cannot write " << dir << "/checkpoint.props" << endl;
+	}
+
+}
+
+
+void Model::fillCheckpointPart(CheckpointPart& aPart) {
+
+	aPart.version = CHECKPOINT_VERSION;
+	aPart.rank    = _proc;
+	aPart.n_proc  = RepastProcess::instance()->worldSize();
+	ostringstream engine;
+	engine << Random::instance()->engine();
+	aPart.engine = engine.str();
+
+	vector<int> location;
+	aPart.agents.reserve(_agents->size());
+	aPart.locations.reserve(2 * _agents->size());
+	for( auto it = _agents->localBegin(); it != _agents->localEnd(); it++ ) {
+		providePackage(&**it, aPart.agents);
+		_discrete_space->getLocation((*it)->getId(), location);
+		aPart.locations.push_back(location[0]);
+		aPart.locations.push_back(location[1]);
+	}
+	for( const auto& n : _network.getNodes() ) {
+		if( n.second.getInfected() == 0 ) continue;
+		aPart.infected_nodes.push_back(n.first);
+		aPart.infected_nodes.push_back(n.second.getInfected());
+	}
+
+}
+
+
+void Model::restoreCheckpoint(const std::string& aDir) {
+
+	if( !boost::filesystem::exists(aDir + "/checkpoint.props") ) {
+		throw std::runtime_error(aDir + " is not a complete checkpoint");
+	}
+	Properties global(aDir + "/checkpoint.props");
+	_start_tick     = repast::strToInt(global.getProperty("tick"));
+	_time_of_day    = repast::strToInt(global.getProperty("time_of_day"));
+	_days_simulated = repast::strToInt(global.getProperty("days_simulated"));
+	int n_proc = repast::strToInt(global.getProperty("process.count"));
+	bool same_proc = n_proc == RepastProcess::instance()->worldSize();
+	if( _proc == 0 ) {
+		cout << "... restarting from " << aDir << " (tick " << _start_tick << ", " << n_proc << " processes)" << endl;
+	}
+
+	// parts to read: the one of the process, or all of them to redistribute the agents
+	vector<int> ranks;
+	if( same_proc ) {
+		ranks.push_back(_proc);
+	} else {
+		for( int r = 0; r < n_proc; r++ ) ranks.push_back(r);
+	}
+
+	map<int, Node> nodes = _network.getNodes();
+	for( auto r : ranks ) {
+
+		CheckpointPart part;
+		readCheckpointPart(aDir, r, part);
+
+		// ... the random streams can only be continued on the same process
+		if( same_proc ) {
+			istringstream engine(part.engine);
+			engine >> Random::instance()->engine();
+		}
+
+		restoreCheckpointPart(part, same_proc, nodes);
+
+	}
+
+	long n_infected_nodes = 0;
+	for( const auto& n : nodes ) {
+		if( n.second.getInfected() > 0 ) n_infected_nodes++;
+	}
+	_network.setNodes(nodes);
+	_network.setNInfectedNodes(n_infected_nodes);
+
+	// ... new random streams, distinct from the ones of the first run
+	if( !same_proc ) {
+		Random::instance()->engine().seed(Random::instance()->seed() + _start_tick);
+	}
+
+}
+
+
+void Model::restoreCheckpointPart(CheckpointPart& aPart, bool aSameProc, std::map<int, Node>& aNodes) {
+
+	for( unsigned int a = 0; a < aPart.agents.size(); a++ ) {
+		int x = aPart.locations[2 * a];
+		if( !aSameProc && !isInLocalBounds(x) ) continue;
+		IndividualPackage& package = aPart.agents[a];
+		if( !aSameProc ) package.init_proc = _proc;
+		package.cur_proc = _proc;
+		Individual* ind = createAgent(package);
+		addAgent(ind);
+		vector<int> location = { x, aPart.locations[2 * a + 1] };
+		_discrete_space->moveTo(ind->getId(), location);
 	}
-	catch(const xmlpp::exception& ex) {
-		cerr << "libxml++ exception: " << ex.what() << endl;
+
+	for( unsigned int i = 0; i < aPart.infected_nodes.size(); i += 2 ) {
+		auto n = aNodes.find(aPart.infected_nodes[i]);
+		if( n != aNodes.end() ) n->second.setInfected(aPart.infected_nodes[i + 1]);
 	}
 
 }
@@ -140,8 +712,17 @@ void Model::synch_agents() {
   //	cout << "INFO: SYNC - Proc " << _proc << " sending agent " << a.first.id() << " to proc " << a.second << endl;
   //	}
 	
-	_discrete_space->balance(_map_agents_to_move_process);
-	repast::RepastProcess::instance()->synchronizeAgentStatus<Individual,IndividualPackage,Model,Model,Model>(*this->_agents, *this, *this, *this);
+	bool timed = StepProfiler::instance().isEnabled();
+	{
+		ScopedTrace trace("balance", "mpi");
+		ScopedPhase timer(PHASE_BALANCE, timed);
+		_discrete_space->balance(_map_agents_to_move_process);
+	}
+	{
+		ScopedTrace trace("synchronizeAgentStatus", "mpi");
+		ScopedPhase timer(PHASE_SYNC, timed);
+		repast::RepastProcess::instance()->synchronizeAgentStatus<Individual,IndividualPackage,Model,Model,Model>(*this->_agents, *this, *this, *this);
+	}
 
 }
 
@@ -151,9 +732,20 @@ void Model::initSchedule() {
 	// Initialize the scheduler
 	ScheduleRunner & runner = RepastProcess::instance()->getScheduleRunner();
 
+	// all the replicas are simulated until they are extinct
+	_active_replicas = _lanes;
+	_local_active.assign(_lanes.size(), 0);
+
+	// latent and infectious agents of the process (see step)
+	_n_active_local = 0;
+	for( auto it = _agents->localBegin(); it != _agents->localEnd(); it++ ) {
+		if( isActive(**it) ) _n_active_local++;
+	}
+
 	// Call the step method on the Model every tick
-	runner.scheduleEvent(1, 1, Schedule::FunctorPtr(new MethodFunctor<Model>(this, &Model::resetDataInd)));
-	runner.scheduleEvent(1, 1, Schedule::FunctorPtr(new MethodFunctor<Model>(this, &Model::step)));
+	// (from the tick following the checkpoint when restarting)
+	runner.scheduleEvent(_start_tick + 1, 1, Schedule::FunctorPtr(new MethodFunctor<Model>(this, &Model::resetDataInd)));
+	runner.scheduleEvent(_start_tick + 1, 1, Schedule::FunctorPtr(new MethodFunctor<Model>(this, &Model::step)));
 
 	// Stopping the model when reaching the desired number of iteration
 	int stop_at = repast::strToInt(_props.getProperty("stop"));
@@ -163,7 +755,16 @@ void Model::initSchedule() {
 	//runner.scheduleEvent(1, 1, Schedule::FunctorPtr(new MethodFunctor<DataSet>(_data_collection, &DataSet::record)));
 	//runner.scheduleEndEvent(Schedule::FunctorPtr(new MethodFunctor<DataSet>(_data_collection, &DataSet::record)));
 
+	// ... the rows recorded so far are appended to the output file every output.flush.interval ticks
+	// (0: only at the end of the simulation), the remaining ones at the end
+	int flush_interval = 0;
+	if( _props.contains("output.flush.interval") ) flush_interval = repast::strToInt(_props.getProperty("output.flush.interval"));
+	if( flush_interval > 0 ) {
+		int first_flush = (_start_tick / flush_interval + 1) * flush_interval;
+		runner.scheduleEvent(first_flush, flush_interval, Schedule::FunctorPtr(new MethodFunctor<DataSet>(_data_collection, &DataSet::write)));
+	}
 	runner.scheduleEndEvent(Schedule::FunctorPtr(new MethodFunctor<DataSet>(_data_collection, &DataSet::write)));
+	runner.scheduleEndEvent(Schedule::FunctorPtr(new MethodFunctor<SVDataSet>(_data_collection, &SVDataSet::flush)));
 
 }
 
@@ -174,6 +775,8 @@ void Model::providePackage(Individual * agent, std::vector<IndividualPackage>& o
 	IndividualPackage package = { id.id(), id.startingRank(), id.agentType(), id.currentRank(),
 			agent->getAgenda(), agent->getCurAct(), agent->getAgeCl(), agent->getGender(), agent->getSocioProStatus(),
 			agent->getEduLevel(), agent->getState(), agent->getTimeTransition() };
+	package.replicas = agent->getReplicas();
+	package.planes = agent->getPlanes();
 	out.push_back(package);
 
 }
@@ -182,8 +785,12 @@ void Model::providePackage(Individual * agent, std::vector<IndividualPackage>& o
 Individual * Model::createAgent(IndividualPackage package) {
 
 	repast::AgentId id(package.id, package.init_proc, MODEL_AGENT_IND_TYPE, package.cur_proc);
-	return new Individual(id, package.agenda, package.cur_act, package.age_cl, package.gender,
+	Individual* agent = new Individual(id, package.agenda, package.cur_act, package.age_cl, package.gender,
 			package.socio_pro_status, package.edu_level, package.state, package.time_next_state);
+	agent->setReplicas(package.replicas);
+	agent->setPlanes(package.planes);
+	if( isActive(*agent) ) _n_active_local++;
+	return agent;
 
 }
 
@@ -209,6 +816,8 @@ void Model::updateAgent(IndividualPackage package) {
 	agent->setSocioProStatus(package.socio_pro_status);
 	agent->setEduLevel(package.edu_level);
 	agent->setState(package.state);
+	agent->setReplicas(package.replicas);
+	agent->setPlanes(package.planes);
 
 }
 
@@ -217,8 +826,8 @@ void Model::step() {
 
 	// convert current tick to current time of day (in seconds from midnight)
 	// int tick = boost::lexical_cast<int>(repast::RepastProcess::instance()->getScheduleRunner().currentTick());
-	static int time_of_day    = 0;
-	static int days_simulated = 0;
+	int& time_of_day    = _time_of_day;
+	int& days_simulated = _days_simulated;
 	if( time_of_day > 86400 ) {
 		time_of_day = time_of_day - 86400;
 		days_simulated++;
@@ -226,85 +835,168 @@ void Model::step() {
 	}
 
 	time_of_day++;
+	int tick = (int)RepastProcess::instance()->getScheduleRunner().currentTick();
+	TraceRecorder::instance().setTick(tick);
+	ScopedTrace trace_step("step");
 
 	// clearing the map containing the agents to be moved between processes
 	_map_agents_to_move_process.clear();
 
+	// replicas with latent or infectious agents on the process, at the extinction check ticks
+	bool check_extinction = _extinction_interval > 0 && tick % _extinction_interval == 0;
+	if( check_extinction ) fill(_local_active.begin(), _local_active.end(), 0);
+
 	//Moore2DGridQuery<Individual> moore2DQuery(_discrete_space);
 	
-	// Loop over every agents
+	// without latent nor infectious agents on the process, only the activities and moves are done
+	bool idle = _n_active_local == 0;
+	long n_active = 0;
 
+	// Loop over every agents, the per agent phases being timed and traced on a sample of the agents
+
+	StepProfiler& profiler = StepProfiler::instance();
+	TraceRecorder& recorder = TraceRecorder::instance();
+	bool timed = profiler.isEnabled();
+	vector<int> agt_location;
+	int64_t agents_begin = recorder.isRecording() ? recorder.now() : -1;
 	auto it_agent = (*_agents).localBegin();
 	while( it_agent != (*_agents).localEnd()) {
 
-		// check if agent is latent and should become (asymptomic) infectious
-		if( (*it_agent)->getState() == state_inf::LATENT ) {
-			(*it_agent)->decreaseTimeTransition();
-			if( (*it_agent)->getTimeTransition() == 0 ) {
-				(*it_agent)->determineInfectiousType(_p_a);
-				//cout << "INFO: TICK " << time_of_day << ", Proc " << _proc << ": Agent " << (*it_agent)->getId().id() << " moves from LATENT to " << (*it_agent)->getState() << endl;
+		// disease progression, in every replica of the ensemble
+		bool infectious = false;
+		bool active = false;
+		bool sampled = profiler.sample();
+		bool traced = recorder.sample();
+		{
+			ScopedTrace trace("progression", "agent", traced && !idle);
+			ScopedPhase timer(PHASE_PROGRESSION, sampled && !idle, profiler.getSampling());
+			if( idle ) {
+				// ... no disease progression on an idle process
 			}
-		}
+			else if( _packed ) {
+				infectious = progressPacked(**it_agent);
+				const std::vector<ReplicaPlanes>& planes = (*it_agent)->getPlanes();
+				for( unsigned int w = 0; w < planes.size(); w++ ) {
+					uint64_t lanes = planes[w].latent() | planes[w].infectious();
+					if( check_extinction ) _local_active[w] |= lanes;
+					active = active || lanes != 0;
+				}
+			}
+			else for( int r = 0; r < _n_replicas; r++ ) {
+
+				// ... the extinct replicas being left out
+				if( ((_active_replicas[r / REPLICA_LANES] >> (r % REPLICA_LANES)) & 1) == 0 ) continue;
+
+				// check if agent is latent and should become (asymptomic) infectious
+				if( (*it_agent)->getState(r) == state_inf::LATENT ) {
+					(*it_agent)->decreaseTimeTransition(r);
+					if( (*it_agent)->getTimeTransition(r) == 0 ) {
+						(*it_agent)->determineInfectiousType(_p_a, r);
+						if( r == 0 && _strata != NULL ) _strata->changeState(**it_agent, state_inf::LATENT);
+						//cout << "INFO: TICK " << time_of_day << ", Proc " << _proc << ": Agent " << (*it_agent)->getId().id() << " moves from LATENT to " << (*it_agent)->getState() << endl;
+					}
+				}
+
+				// check if agent is infectious and should recover
+				if( (*it_agent)->getState(r) == state_inf::INFECTIOUS_ASYMPT
+						|| (*it_agent)->getState(r) == state_inf::INFECTIOUS_SYMPT ) {
+					(*it_agent)->decreaseTimeTransition(r);
+					if( (*it_agent)->getTimeTransition(r) == 0 ) {
+						state_inf previous_state = (*it_agent)->getState(r);
+						(*it_agent)->setState(r, state_inf::RECOVERED);
+						if( r == 0 && _strata != NULL ) _strata->changeState(**it_agent, previous_state);
+						//cout << "INFO: TICK " << time_of_day << ", Proc " << _proc << ": Agent " << (*it_agent)->getId().id() << " moves from INFECTED to " << (*it_agent)->getState() << endl;
+					}
+				}
+
+				state_inf state = (*it_agent)->getState(r);
+				infectious = infectious || state == state_inf::INFECTIOUS_ASYMPT || state == state_inf::INFECTIOUS_SYMPT;
+				if( state != state_inf::SUSCEPTIBLE && state != state_inf::RECOVERED ) {
+					if( check_extinction ) _local_active[r / REPLICA_LANES] |= (uint64_t)1 << (r % REPLICA_LANES);
+					active = true;
+				}
 
-		// check if agent is infectious and should recover
-		if( (*it_agent)->getState() == state_inf::INFECTIOUS_ASYMPT
-				|| (*it_agent)->getState() == state_inf::INFECTIOUS_SYMPT ) {
-			(*it_agent)->decreaseTimeTransition();
-			if( (*it_agent)->getTimeTransition() == 0 ) {
-				(*it_agent)->setState(state_inf::RECOVERED);
-				//cout << "INFO: TICK " << time_of_day << ", Proc " << _proc << ": Agent " << (*it_agent)->getId().id() << " moves from INFECTED to " << (*it_agent)->getState() << endl;
 			}
 		}
 
-		//  check current activity times
+		if( active ) n_active++;
+
+		//  check current activity times, the location being only needed to infect or move
 		int start_time_act = (*it_agent)->getCurActStartingTime();
 		int end_time_act   = (*it_agent)->getCurActEndTime();
-		vector<int> agt_location;
-		_discrete_space->getLocation((*it_agent)->getId(),agt_location);
+		if( infectious || end_time_act == time_of_day || start_time_act == time_of_day - 1 ) {
+			ScopedTrace trace("location", "agent", traced);
+			ScopedPhase timer(PHASE_LOCATION, sampled, profiler.getSampling());
+			_discrete_space->getLocation((*it_agent)->getId(),agt_location);
+		}
 
-		// if agent is infected, queries the agents on the same spot to tries to infect them
-		if( (*it_agent)->getState() == state_inf::INFECTIOUS_ASYMPT
-				|| (*it_agent)->getState() == state_inf::INFECTIOUS_SYMPT ) {
+		// if agent is infected (in any replica), queries the agents on the same spot to tries to infect them
+		if( infectious ) {
 
 			// ... recording infected node
-			_network.addInfectedNode(agt_location[0]);
+			if( (*it_agent)->getState() == state_inf::INFECTIOUS_ASYMPT
+					|| (*it_agent)->getState() == state_inf::INFECTIOUS_SYMPT ) {
+				_network.addInfectedNode(agt_location[0]);
+			}
 
 			// ... agents are performing an activity somewhere
 			if (time_of_day <= end_time_act && start_time_act <= time_of_day && agt_location[1] == 0) {
 
-				// queries agent on a node
+				// queries agent on a node, once for all the replicas
 				vector<Individual*> agents_on_node;
-				Point<int> node_location(agt_location[0], 0);
-				_moore2DQuery->query(node_location, 0, true, agents_on_node);
+				{
+					ScopedTrace trace("query", "agent", traced);
+					ScopedPhase timer(PHASE_QUERY, sampled, profiler.getSampling());
+					Point<int> node_location(agt_location[0], 0);
+					_moore2DQuery->query(node_location, 0, true, agents_on_node);
+				}
 
-				// loop on the agents
-				int n_interactions = 0;
-				auto agt = agents_on_node.begin();
-				while( n_interactions < _max_inf && agt != agents_on_node.end() ) {
+				ScopedTrace trace("infection", "agent", traced);
+				ScopedPhase timer(PHASE_INFECTION, sampled, profiler.getSampling());
 
-					// only infect the susceptible agents
-					if( (*agt)->getState() == state_inf::SUSCEPTIBLE ) {
+				if( _packed ) n_active += infectPacked(**it_agent, agents_on_node, agt_location[0], tick);
+				else for( int r = 0; r < _n_replicas; r++ ) {
 
-						//bool latent = false;
-						if( (*it_agent)->getState() == state_inf::INFECTIOUS_ASYMPT ) {
-							//latent =
-							(*agt)->isLatent( _r_beta_x_beta );
+					state_inf state = (*it_agent)->getState(r);
+					if( state != state_inf::INFECTIOUS_ASYMPT && state != state_inf::INFECTIOUS_SYMPT ) continue;
 
-						} else {
-							//latent =
-							(*agt)->isLatent( _beta );
-						}
+					// loop on the agents
+					int n_interactions = 0;
+					auto agt = agents_on_node.begin();
+					while( n_interactions < _max_inf && agt != agents_on_node.end() ) {
+
+						// only infect the susceptible agents
+						if( (*agt)->getState(r) == state_inf::SUSCEPTIBLE ) {
+
+							bool latent = false;
+							if( state == state_inf::INFECTIOUS_ASYMPT ) {
+								latent = (*agt)->isLatent( _r_beta_x_beta, r );
+
+							} else {
+								latent = (*agt)->isLatent( _beta, r );
+							}
+
+							// ... counted as a new active agent, even if it is already active in another replica
+							if( latent ) n_active++;
+							if( latent && r == 0 && _strata != NULL ) {
+								_strata->changeState(**agt, state_inf::SUSCEPTIBLE);
+							}
+							if( latent && r == 0 && _transmissions != NULL ) {
+								_transmissions->add(tick, (*it_agent)->getId().id(), (*agt)->getId().id(), agt_location[0], state);
+							}
+
+							/*
+							if( latent == true ) {
+								cout << "INFO: TICK " << time_of_day << ", Proc " << _proc << ": Agent " << (*it_agent)->getId().id() << " moves from SUSCEPTIBLE to " << (*agt)->getState() << endl;
+							}
+							*/
 
-						/*
-						if( latent == true ) {
-							cout << "INFO: TICK " << time_of_day << ", Proc " << _proc << ": Agent " << (*it_agent)->getId().id() << " moves from SUSCEPTIBLE to " << (*agt)->getState() << endl;
 						}
-						*/
 
-					}
+						agt++;
+						n_interactions++;
 
-					agt++;
-					n_interactions++;
+					}
 
 				}
 
@@ -314,11 +1006,14 @@ void Model::step() {
 
 		// the agent should be paused until next activity
 		if( end_time_act == time_of_day ) {
+			ScopedTrace trace("activity", "agent", traced);
+			ScopedPhase timer(PHASE_ACTIVITY, sampled, profiler.getSampling());
 			// ... removing it from its current location
 			//cout << "INFO: TICK " << time_of_day << ", Proc " << _proc << ": Agent " << (*it_agent)->getId().id() << " END ACT, SCHEDULE NEXT ONE!" << endl;
 			agt_location[1] = 1;
 			_discrete_space->moveTo((*it_agent)->getId(),agt_location);
 			// ... setting next activity
+			int previous_stratum = (_strata != NULL && _strata->usesActivity()) ? _strata->getStratum(**it_agent) : -1;
 			bool has_next_activity = (*it_agent)->setNextAct();
 
 			// ... if no more activity then reset the schedule
@@ -332,15 +1027,18 @@ void Model::step() {
 
 					// ... checking if the agent needs to be moved to another process
 					if( isInLocalBounds(agt_location[0]) == false ) {
-						_map_agents_to_move_process[(*it_agent)->getId()] = _map_node_process[agt_location[0]];
+						_map_agents_to_move_process[(*it_agent)->getId()] = getNodeProcess(agt_location[0]);
 					}
 				}
 			}
+			if( previous_stratum >= 0 ) _strata->changeStratum(**it_agent, previous_stratum);
 
 		}
 
 		// the agent will resume at the next tick and be moved to next activity
 		if( start_time_act == time_of_day - 1 ) {
+			ScopedTrace trace("activity", "agent", traced);
+			ScopedPhase timer(PHASE_ACTIVITY, sampled, profiler.getSampling());
 			 // ... moving it to the right location
 			 agt_location[0] = (*it_agent)->getCurActNodeId();
 			 agt_location[1] = 0;
@@ -348,46 +1046,178 @@ void Model::step() {
 
 		     // ... checking if the agent needs to be moved to another process
 		     if( isInLocalBounds(agt_location[0]) == false ) {
-		    	 _map_agents_to_move_process[(*it_agent)->getId()] = _map_node_process[agt_location[0]];
+		    	 _map_agents_to_move_process[(*it_agent)->getId()] = getNodeProcess(agt_location[0]);
 		     }
 
 		}
 
 		// aggregate data
 		Individual& ind = *(*it_agent);
-		gatherDataInd( ind );
+		{
+			ScopedTrace trace("gather", "agent", traced);
+			ScopedPhase timer(PHASE_GATHER, sampled, profiler.getSampling());
+			gatherDataInd( ind );
+		}
 
 		// next agent
 		it_agent++;
 
 	}
+	if( agents_begin >= 0 ) recorder.add("agents", "step", agents_begin);
 
 	// Recording aggregate data
 	_total_nodes_infected.setData(_network.getNInfectedNodes());
-	_data_collection->record();
+	{
+		ScopedTrace trace("record");
+		ScopedPhase timer(PHASE_RECORD, timed);
+		_data_collection->record();
+	}
+
+	// active agents left on the process (an upper bound, the agents infected being counted again), those
+	// arriving being counted by createAgent
+	_n_active_local = n_active;
+	if( _n_active_local > 0 ) {
+		for( const auto& a : _map_agents_to_move_process ) {
+			if( isActive(*_agents->getAgent(a.first)) ) _n_active_local--;
+		}
+	}
 
 	synch_agents();
 
+	// per node output, once the agents are on the process of their node
+	if( _node_series != NULL && tick % _node_series_interval == 0 ) {
+		ScopedTrace trace("node_series", "io");
+		recordNodeSeries(tick);
+	}
+	if( _strata != NULL && tick % _strata->getInterval() == 0 ) {
+		ScopedTrace trace("strata", "mpi");
+		_strata->write(tick, *RepastProcess::instance()->getCommunicator());
+	}
+	if( _ensemble != NULL && tick % _ensemble->getInterval() == 0 ) {
+		ScopedTrace trace("ensemble", "mpi");
+		for( auto it = _agents->localBegin(); it != _agents->localEnd(); it++ ) _ensemble->add(**it);
+		_ensemble->write(tick, *RepastProcess::instance()->getCommunicator());
+	}
+
 	if( time_of_day % 3600 == 0) {
 		std::ostringstream screen_output;
 		screen_output << "INFO: HOUR " << time_of_day / 3600 << " done on Proc " << repast::RepastProcess::instance()->rank() << " (" << _agents->size() << " agents)" << endl;
 		std::cout << screen_output.str();
+		StepProfiler::instance().writeInterval(tick / 3600);
 	}
 
+	// checkpoint, once the agents are on the process of their node and the outputs of the tick are done
+	if( _checkpoint_interval > 0 && tick % _checkpoint_interval == 0 ) {
+		ScopedTrace trace("checkpoint", "io");
+		writeCheckpoint(tick);
+	}
+
+	if( check_extinction ) checkExtinction(tick);
+
 }
 
 
-void Model::constructMapNodeProcess() {
+bool Model::progressPacked(Individual& aInd) {
 
-	boost::mpi::communicator* comm = RepastProcess::instance()->getCommunicator();
+	state_inf previous_state = aInd.getState();
+	bool infectious = false;
+	std::vector<ReplicaPlanes>& planes = aInd.getPlanes();
+	for( unsigned int w = 0; w < planes.size(); w++ ) {
 
-	// gathering data from every process
-	vector<map<int, int>> result_gather;
-	boost::mpi::all_gather(*comm, _map_node_process, result_gather);
+		// ... the lanes becoming infectious only recover from the next tick
+		uint64_t recovery = _draw_recovery.draw(planes[w].infectious());
+		uint64_t latent_end = _draw_latent_end.draw(planes[w].latent());
+		if( latent_end != 0 ) planes[w].setInfectious(latent_end, _draw_asympt.draw(latent_end));
+		if( recovery != 0 ) planes[w].setRecovered(recovery);
+		infectious = infectious || planes[w].infectious() != 0;
 
-	// updating map with gathered data
-	for( unsigned int i = 0; i < result_gather.size(); i++ ) {
-		_map_node_process.insert( result_gather[i].begin(), result_gather[i].end() );
+	}
+
+	aInd.syncState();
+	if( _strata != NULL && aInd.getState() != previous_state ) _strata->changeState(aInd, previous_state);
+	return infectious;
+
+}
+
+
+int Model::infectPacked(Individual& aInfector, const std::vector<Individual*>& aAgents, int aNodeId, int aTick) {
+
+	const std::vector<ReplicaPlanes>& infector = aInfector.getPlanes();
+	int n_infected = 0;
+	int n_interactions = 0;
+	auto agt = aAgents.begin();
+	while( n_interactions < _max_inf && agt != aAgents.end() ) {
+
+		// susceptible lanes of the agent AND lanes where the infection draw succeeds
+		std::vector<ReplicaPlanes>& planes = (*agt)->getPlanes();
+		uint64_t infected_lane0 = 0;
+		bool infected = false;
+		for( unsigned int w = 0; w < planes.size(); w++ ) {
+			uint64_t susceptible = planes[w].susceptible(_lanes[w]);
+			if( susceptible == 0 ) continue;
+			uint64_t latent = _draw_infect_sympt.draw(susceptible & infector[w].infectiousSympt())
+					| _draw_infect_asympt.draw(susceptible & infector[w].infectiousAsympt());
+			planes[w].setLatent(latent);
+			if( w == 0 ) infected_lane0 = latent & 1;
+			infected = infected || latent != 0;
+		}
+		if( infected ) n_infected++;
+
+		if( infected_lane0 != 0 ) {
+			(*agt)->syncState();
+			if( _strata != NULL ) _strata->changeState(**agt, state_inf::SUSCEPTIBLE);
+			if( _transmissions != NULL ) {
+				_transmissions->add(aTick, aInfector.getId().id(), (*agt)->getId().id(), aNodeId, aInfector.getState());
+			}
+		}
+
+		agt++;
+		n_interactions++;
+
+	}
+
+	return n_infected;
+
+}
+
+
+bool Model::isActive(const Individual& aInd) const {
+
+	if( _packed ) {
+		for( const auto& p : aInd.getPlanes() ) {
+			if( (p.latent() | p.infectious()) != 0 ) return true;
+		}
+		return false;
+	}
+	for( int r = 0; r < _n_replicas; r++ ) {
+		state_inf state = aInd.getState(r);
+		if( state != state_inf::SUSCEPTIBLE && state != state_inf::RECOVERED ) return true;
+	}
+	return false;
+
+}
+
+
+void Model::checkExtinction(int aTick) {
+
+	// a single reduction of the replicas still active on any process
+	vector<uint64_t> active(_local_active.size());
+	ScopedTrace trace("extinction", "mpi");
+	MPI_Allreduce(_local_active.data(), active.data(), active.size(), MPI_UINT64_T, MPI_BOR, *RepastProcess::instance()->getCommunicator());
+
+	int n_extinct = 0, n_active = 0;
+	for( unsigned int w = 0; w < active.size(); w++ ) {
+		n_extinct += __builtin_popcountll(_active_replicas[w] & ~active[w]);
+		_active_replicas[w] &= active[w];
+		n_active += __builtin_popcountll(_active_replicas[w]);
+	}
+
+	if( n_extinct > 0 && _proc == 0 ) {
+		cout << "INFO: Proc " << _proc << ": TICK " << aTick << ": " << n_extinct << " replica(s) extinct, " << n_active << " left" << endl;
+	}
+	if( n_active == 0 ) {
+		if( _proc == 0 ) cout << "INFO: Proc " << _proc << ": TICK " << aTick << ": epidemic extinct, stopping the simulation" << endl;
+		RepastProcess::instance()->getScheduleRunner().stop();
 	}
 
 }
@@ -403,8 +1233,11 @@ bool Model::isInLocalBounds(int nodeId) {
 }
 
 
-const std::map<int, int>& Model::getMapNodeProcess() const {
-	return _map_node_process;
+int Model::getNodeProcess(int aNodeId) const {
+
+	if( aNodeId < 0 || aNodeId >= _n_nodes_network ) throw std::out_of_range("unknown node " + to_string(aNodeId));
+	return Data::getNodeProcess(aNodeId, _n_nodes_network, _n_proc);
+
 }
 
 
@@ -436,7 +1269,7 @@ void Model::initInfectAgents(std::vector<int> nodeIds, std::vector<int> nAgents,
 		//Moore2DGridQuery<Individual> moore2DQuery(_discrete_space);
 		_moore2DQuery->query(node_location, 0, true, agents_on_node);
 
-		if( _map_node_process.at(node_id) == _proc ) {
+		if( getNodeProcess(node_id) == _proc ) {
 
 			cout << "INFO: INFECT AGENTS - " << state << " - node " << node_orig_id << " (" << node_id << ")" << endl;
 
@@ -448,8 +1281,10 @@ void Model::initInfectAgents(std::vector<int> nodeIds, std::vector<int> nAgents,
 				// only infect the suscpetible agents
 				if( (*agt)->getState() == state_inf::SUSCEPTIBLE ) {
 					n_infect++;
-					(*agt)->setState(state);
-					(*agt)->setTimeTransition((int)(Random::instance()->getGenerator("mu")->next() * 86400));
+					for( int r = 0; r < _n_replicas; r++ ) {
+						(*agt)->setState(r, state);
+						if( !_packed ) (*agt)->setTimeTransition(r, (int)(Random::instance()->getGenerator("mu")->next() * 86400));
+					}
 					(*agt)->print();
 				}
 				agt++;
@@ -490,6 +1325,34 @@ void Model::gatherDataInd(const Individual& aInd) {
 }
 
 
+void Model::recordNodeSeries(double aTick) {
+
+	size_t n_local = _node_values.size() / 2;
+	fill(_node_values.begin(), _node_values.end(), 0);
+	vector<int> location;
+	for( auto it = _agents->localBegin(); it != _agents->localEnd(); it++ ) {
+		state_inf state = (*it)->getState();
+		if( state == state_inf::SUSCEPTIBLE || state == state_inf::RECOVERED ) continue;
+		_discrete_space->getLocation((*it)->getId(), location);
+		size_t node = location[0] - _first_node;
+		if( node >= n_local ) continue;
+		if( state == state_inf::LATENT ) {
+			_node_values[n_local + node]++;
+		} else {
+			_node_values[node]++;
+		}
+	}
+
+	try {
+		_node_series->writeFrame(aTick, _node_values);
+	}
+	catch(const std::exception& ex) {
+		cerr << "ERROR: Proc " << _proc << ": " << ex.what() << endl;
+	}
+
+}
+
+
 void Model::resetDataInd() {
 	_total_susceptible.resetData();
 	_total_latent.resetData();
@@ -36,10 +36,10 @@ void Network::addNode(Node aNode) {
 
 }
 
-void Network::dumpNodes(int aId) {
+void Network::dumpNodes(const std::string& aSuffix) {
 
 	ofstream f_out;
-	f_out.open("dump_nodes" + to_string(aId), ios::out);
+	f_out.open("dump_nodes" + aSuffix, ios::out);
 
 	for( auto n : _Nodes ) {
 
@@ -0,0 +1,105 @@
+/****************************************************************
+ * NODESERIES.CPP
+ *
+ * This file contains all the definitions of the methods of
+ * NodeSeries.hpp (see this file for methods' documentation)
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+#include "../include/NodeSeries.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+
+NodeSeriesWriter::NodeSeriesWriter(const std::string& aFilename, MPI_Comm aComm, const std::vector<std::string>& aColumns,
+		uint64_t aNNodes, int aFirstNode, int aLastNode, uint64_t aInterval) :
+	_filename(aFilename), _comm(aComm), _rank(0), _file(MPI_FILE_NULL), _view(MPI_DATATYPE_NULL),
+	_n_columns(aColumns.size()), _n_nodes(aNNodes), _n_local(aLastNode >= aFirstNode ? aLastNode - aFirstNode + 1 : 0),
+	_n_frames(0), _index() {
+
+	MPI_Comm_rank(aComm, &_rank);
+
+	NodeSeriesHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, NODE_SERIES_MAGIC, sizeof(header.magic));
+	header.version       = NODE_SERIES_VERSION;
+	header.n_columns     = _n_columns;
+	header.n_nodes       = aNNodes;
+	header.interval      = aInterval;
+	header.frames_offset = sizeof(NodeSeriesHeader);
+	string columns;
+	for( unsigned int c = 0; c < aColumns.size(); c++ ) {
+		columns += (c > 0 ? ";" : "") + aColumns[c];
+	}
+	if( columns.size() >= sizeof(header.columns) ) {
+		throw runtime_error("the column names of " + aFilename + " are too long");
+	}
+	memcpy(header.columns, columns.c_str(), columns.size());
+
+	if( MPI_File_open(aComm, const_cast<char*>(aFilename.c_str()), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL,
+			&_file) != MPI_SUCCESS ) {
+		_file = MPI_FILE_NULL;
+		throw runtime_error("cannot create " + aFilename);
+	}
+	MPI_File_set_size(_file, 0);
+
+	int status = MPI_SUCCESS;
+	if( _rank == 0 ) {
+		status = MPI_File_write_at(_file, 0, &header, sizeof(header), MPI_BYTE, MPI_STATUS_IGNORE);
+		_index.open((aFilename + ".idx").c_str());
+		_index << "frame;tick;offset" << endl;
+		if( status == MPI_SUCCESS && !_index ) status = MPI_ERR_OTHER;
+	}
+	// ... every process failing with the process 0
+	MPI_Bcast(&status, 1, MPI_INT, 0, aComm);
+	if( status != MPI_SUCCESS ) {
+		close();
+		throw runtime_error("cannot write " + aFilename);
+	}
+
+	// the nodes range of the process in every column, repeated frame after frame
+	MPI_Datatype range;
+	MPI_Type_vector(_n_columns, _n_local, _n_nodes, MPI_INT32_T, &range);
+	MPI_Type_create_resized(range, 0, _n_columns * _n_nodes * sizeof(int32_t), &_view);
+	MPI_Type_commit(&_view);
+	MPI_Type_free(&range);
+	MPI_File_set_view(_file, header.frames_offset + (MPI_Offset)aFirstNode * sizeof(int32_t), MPI_INT32_T, _view,
+			const_cast<char*>("native"), MPI_INFO_NULL);
+
+}
+
+
+NodeSeriesWriter::~NodeSeriesWriter() {
+	close();
+}
+
+
+void NodeSeriesWriter::writeFrame(double aTick, const std::vector<int32_t>& aValues) {
+
+	if( _file == MPI_FILE_NULL ) throw runtime_error(_filename + " is closed");
+	if( aValues.size() != _n_columns * _n_local ) throw runtime_error("invalid frame size for " + _filename);
+
+	int status = MPI_File_write_at_all(_file, _n_frames * _n_columns * _n_local, const_cast<int32_t*>(aValues.data()),
+			aValues.size(), MPI_INT32_T, MPI_STATUS_IGNORE);
+	if( status != MPI_SUCCESS ) throw runtime_error("error while writing " + _filename);
+
+	if( _rank == 0 ) {
+		_index << _n_frames << ";" << aTick << ";"
+				<< sizeof(NodeSeriesHeader) + _n_frames * _n_columns * _n_nodes * sizeof(int32_t) << endl;
+	}
+	_n_frames++;
+
+}
+
+
+void NodeSeriesWriter::close() {
+
+	if( _file != MPI_FILE_NULL ) MPI_File_close(&_file);
+	if( _view != MPI_DATATYPE_NULL ) MPI_Type_free(&_view);
+	if( _index.is_open() ) _index.close();
+
+}
@@ -0,0 +1,460 @@
+/****************************************************************
+ * POPULATION.CPP
+ *
+ * This file contains all the definitions of the methods of
+ * Population.hpp (see this file for methods' documentation)
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+#include "../include/Population.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <stdexcept>
+#include <iostream>
+
+using namespace std;
+
+
+//////////////////////
+// PopulationWriter //
+//////////////////////
+
+
+PopulationWriter::PopulationWriter(const std::string& aFilename, uint64_t aNNodes, double aSampleSize, uint64_t aSampleSeed,
+		uint64_t aNShards) :
+	_filename(aFilename), _tmp_filename(aFilename + ".acts.tmp"), _persons_filename(aFilename + ".persons.tmp"),
+	_out(NULL), _tmp(NULL), _persons(NULL), _n_nodes(aNNodes), _n_activities(0), _sample_size(aSampleSize),
+	_sample_seed(aSampleSeed), _n_shards(aNShards > 0 ? aNShards : 1), _home_nodes() {
+
+	_out     = fopen(_filename.c_str(), "wb");
+	_tmp     = fopen(_tmp_filename.c_str(), "w+b");
+	_persons = fopen(_persons_filename.c_str(), "w+b");
+	if( _out == NULL || _tmp == NULL || _persons == NULL ) {
+		throw runtime_error("cannot open " + _filename + " for writing");
+	}
+
+}
+
+
+PopulationWriter::~PopulationWriter() {
+	if( _out != NULL ) fclose(_out);
+	if( _tmp != NULL ) {
+		fclose(_tmp);
+		remove(_tmp_filename.c_str());
+	}
+	if( _persons != NULL ) {
+		fclose(_persons);
+		remove(_persons_filename.c_str());
+	}
+}
+
+
+void PopulationWriter::addPerson(PersonRecord aPerson, const std::vector<ActivityRecord>& aActivities) {
+
+	aPerson.home_node      = aActivities.empty() ? -1 : aActivities.front().node_id;
+	aPerson.n_activities   = aActivities.size();
+	aPerson.first_activity = _n_activities;
+	memset(aPerson.padding, 0, sizeof(aPerson.padding));
+
+	fwrite(&aPerson, sizeof(PersonRecord), 1, _persons);
+	if( !aActivities.empty() ) {
+		fwrite(&aActivities[0], sizeof(ActivityRecord), aActivities.size(), _tmp);
+	}
+
+	_n_activities += aActivities.size();
+	_home_nodes.push_back(aPerson.home_node);
+
+}
+
+
+void PopulationWriter::finish() {
+
+	fflush(_persons);
+	fflush(_tmp);
+	if( ferror(_persons) || ferror(_tmp) ) {
+		throw runtime_error("error while writing the temporary files of " + _filename);
+	}
+	MappedFile persons_file(_persons_filename, false);
+	MappedFile activities_file(_tmp_filename, false);
+	const PersonRecord*   persons    = reinterpret_cast<const PersonRecord*>(persons_file.data());
+	const ActivityRecord* activities = reinterpret_cast<const ActivityRecord*>(activities_file.data());
+
+	PopulationHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, POPULATION_MAGIC, sizeof(header.magic));
+	header.version            = POPULATION_VERSION;
+	header.byte_order         = POPULATION_BYTE_ORDER;
+	header.n_persons          = _home_nodes.size();
+	header.n_activities       = _n_activities;
+	header.n_nodes            = _n_nodes;
+	header.sample_size        = _sample_size;
+	header.sample_seed        = _sample_seed;
+	header.n_shards           = _n_shards;
+	header.shard_table_offset = sizeof(PopulationHeader);
+	header.persons_offset     = header.shard_table_offset + _n_shards * sizeof(ShardRecord);
+	header.activities_offset  = header.persons_offset + header.n_persons * sizeof(PersonRecord);
+
+	// ... persons order (counting sort on the shards, keeping the file order in each shard)
+	vector<uint64_t> shard_index(_n_shards + 1, 0);
+	vector<uint32_t> shards(_home_nodes.size());
+	for( uint32_t p = 0; p < _home_nodes.size(); p++ ) {
+		int32_t h = _home_nodes[p];
+		shards[p] = ( h >= 0 && (uint64_t)h < _n_nodes ) ? Data::getNodeProcess(h, _n_nodes, _n_shards) : 0;
+		shard_index[shards[p] + 1]++;
+	}
+	for( uint64_t s = 0; s < _n_shards; s++ ) {
+		shard_index[s + 1] += shard_index[s];
+	}
+	vector<uint32_t> order(_home_nodes.size());
+	{
+		vector<uint64_t> next(shard_index.begin(), shard_index.end() - 1);
+		for( uint32_t p = 0; p < _home_nodes.size(); p++ ) {
+			order[next[shards[p]]++] = p;
+		}
+	}
+	vector<uint32_t>().swap(shards);
+
+	// ... shard table
+	vector<ShardRecord> shard_table(_n_shards);
+	uint64_t n_activities = 0;
+	for( uint64_t s = 0; s < _n_shards; s++ ) {
+		shard_table[s].first_person   = shard_index[s];
+		shard_table[s].n_persons      = shard_index[s + 1] - shard_index[s];
+		shard_table[s].first_activity = n_activities;
+		for( uint64_t q = shard_index[s]; q < shard_index[s + 1]; q++ ) {
+			n_activities += persons[order[q]].n_activities;
+		}
+		shard_table[s].n_activities   = n_activities - shard_table[s].first_activity;
+	}
+	fseek(_out, header.shard_table_offset, SEEK_SET);
+	fwrite(&shard_table[0], sizeof(ShardRecord), shard_table.size(), _out);
+
+	// ... persons and agenda arena, in the shards order
+	n_activities = 0;
+	for( auto p : order ) {
+		PersonRecord person = persons[p];
+		person.first_activity = n_activities;
+		n_activities += person.n_activities;
+		fwrite(&person, sizeof(PersonRecord), 1, _out);
+	}
+	for( auto p : order ) {
+		if( persons[p].n_activities > 0 ) {
+			fwrite(activities + persons[p].first_activity, sizeof(ActivityRecord), persons[p].n_activities, _out);
+		}
+	}
+
+	// ... home index (counting sort on the home nodes, keeping the file order on each node)
+	vector<uint64_t> node_index(_n_nodes + 1, 0);
+	for( auto h : _home_nodes ) {
+		if( h >= 0 && (uint64_t)h < _n_nodes ) node_index[h + 1]++;
+	}
+	for( uint64_t n = 0; n < _n_nodes; n++ ) {
+		node_index[n + 1] += node_index[n];
+	}
+	header.n_indexed = node_index[_n_nodes];
+
+	vector<uint32_t> home_index(header.n_indexed);
+	vector<uint64_t> next(node_index.begin(), node_index.end() - 1);
+	for( uint32_t q = 0; q < order.size(); q++ ) {
+		int32_t h = _home_nodes[order[q]];
+		if( h >= 0 && (uint64_t)h < _n_nodes ) home_index[next[h]++] = q;
+	}
+
+	header.node_index_offset = header.activities_offset + header.n_activities * sizeof(ActivityRecord);
+	header.home_index_offset = header.node_index_offset + node_index.size() * sizeof(uint64_t);
+	fwrite(&node_index[0], sizeof(uint64_t), node_index.size(), _out);
+	if( !home_index.empty() ) {
+		fwrite(&home_index[0], sizeof(uint32_t), home_index.size(), _out);
+	}
+
+	// ... header
+	fseek(_out, 0, SEEK_SET);
+	fwrite(&header, sizeof(header), 1, _out);
+
+	if( ferror(_out) ) {
+		throw runtime_error("error while writing " + _filename);
+	}
+	fclose(_out);
+	_out = NULL;
+
+}
+
+
+////////////////////
+// PopulationFile //
+////////////////////
+
+
+PopulationFile::PopulationFile(const std::string& aFilename) :
+	_filename(aFilename), _file(aFilename), _header(NULL), _persons(NULL), _activities(NULL), _node_index(NULL), _home_index(NULL) {
+
+	const char* data = _file.data();
+	_header = reinterpret_cast<const PopulationHeader*>(data);
+	if( _file.size() < sizeof(PopulationHeader) ) {
+		throw runtime_error(aFilename + " is too small to be a population file");
+	}
+	checkHeader(*_header, _file.size(), aFilename);
+
+	_persons    = reinterpret_cast<const PersonRecord*>(data + _header->persons_offset);
+	_activities = reinterpret_cast<const ActivityRecord*>(data + _header->activities_offset);
+	_node_index = reinterpret_cast<const uint64_t*>(data + _header->node_index_offset);
+	_home_index = reinterpret_cast<const uint32_t*>(data + _header->home_index_offset);
+
+}
+
+
+void PopulationFile::invalid() const {
+	throw runtime_error(_filename + " is not a valid population file");
+}
+
+
+bool PopulationFile::isPopulationFile(const std::string& aFilename) {
+
+	char magic[sizeof(POPULATION_MAGIC)];
+	FILE* f = fopen(aFilename.c_str(), "rb");
+	if( f == NULL ) return false;
+	size_t n_read = fread(magic, 1, sizeof(magic), f);
+	fclose(f);
+
+	return n_read == sizeof(magic) && memcmp(magic, POPULATION_MAGIC, sizeof(magic)) == 0;
+
+}
+
+
+void PopulationFile::checkHeader(const PopulationHeader& aHeader, uint64_t aFileSize, const std::string& aFilename) {
+
+	if( memcmp(aHeader.magic, POPULATION_MAGIC, sizeof(POPULATION_MAGIC)) != 0 ) {
+		throw runtime_error(aFilename + " is not a population file");
+	} else if( aHeader.byte_order != POPULATION_BYTE_ORDER ) {
+		throw runtime_error(aFilename + " was written with a different byte order");
+	} else if( aHeader.version != POPULATION_VERSION ) {
+		throw runtime_error(aFilename + " has format version " + to_string(aHeader.version) + ", expected "
+				+ to_string(POPULATION_VERSION) + " (convert it again)");
+	}
+
+	// every section within the file (without overflow of the offsets and sizes)
+	auto fits = [aFileSize](uint64_t aOffset, uint64_t aCount, uint64_t aSize) {
+		return aOffset <= aFileSize && aCount <= (aFileSize - aOffset) / aSize;
+	};
+	if( !fits(aHeader.persons_offset, aHeader.n_persons, sizeof(PersonRecord))
+			|| !fits(aHeader.activities_offset, aHeader.n_activities, sizeof(ActivityRecord))
+			|| aHeader.n_nodes == UINT64_MAX || !fits(aHeader.node_index_offset, aHeader.n_nodes + 1, sizeof(uint64_t))
+			|| !fits(aHeader.home_index_offset, aHeader.n_indexed, sizeof(uint32_t))
+			|| !fits(aHeader.shard_table_offset, aHeader.n_shards, sizeof(ShardRecord)) ) {
+		throw runtime_error(aFilename + " is truncated or is not a valid population file");
+	}
+
+	// ... and the home index of at most all the persons
+	if( aHeader.n_indexed > aHeader.n_persons ) {
+		throw runtime_error(aFilename + " is not a valid population file");
+	}
+
+}
+
+
+/////////////////////
+// PopulationShard //
+/////////////////////
+
+
+namespace {
+
+	//! Check a shard record against the header of its file.
+	void checkShard(const ShardRecord& aShard, const PopulationHeader& aHeader, const std::string& aFilename) {
+		if( aShard.first_person + aShard.n_persons > aHeader.n_persons
+				|| aShard.first_activity + aShard.n_activities > aHeader.n_activities
+				|| aShard.n_persons > INT_MAX || aShard.n_activities > INT_MAX ) {
+			throw runtime_error(aFilename + " has an invalid shard table");
+		}
+	}
+
+	//! Make the first activity of the persons of a shard relative to its activities.
+	/*!
+	  Throws a std::runtime_error if the agenda of a person is not within the activities of the shard.
+	 */
+	void rebaseShard(PopulationShard& aShard, const PopulationHeader& aHeader, const ShardRecord& aRecord,
+			const std::string& aFilename) {
+		aShard.header = aHeader;
+		for( auto& p : aShard.persons ) {
+			if( p.first_activity < aRecord.first_activity
+					|| p.first_activity - aRecord.first_activity > aRecord.n_activities
+					|| p.n_activities > aRecord.n_activities - (p.first_activity - aRecord.first_activity) ) {
+				throw runtime_error(aFilename + " is not a valid population file (agenda out of its shard)");
+			}
+			p.first_activity -= aRecord.first_activity;
+		}
+	}
+
+	//! Read records at a given offset of a file.
+	void readAt(FILE* aFile, uint64_t aOffset, void* aData, size_t aSize, size_t aCount, const std::string& aFilename) {
+		if( aCount == 0 ) return;
+		if( fseeko(aFile, aOffset, SEEK_SET) != 0 || fread(aData, aSize, aCount, aFile) != aCount ) {
+			throw runtime_error("error while reading " + aFilename);
+		}
+	}
+
+}
+
+
+bool readPopulationShard(const std::string& aFilename, MPI_Comm aComm, PopulationShard& aShard) {
+
+	int rank, n_proc;
+	MPI_Comm_rank(aComm, &rank);
+	MPI_Comm_size(aComm, &n_proc);
+
+	MPI_File file;
+	if( MPI_File_open(aComm, const_cast<char*>(aFilename.c_str()), MPI_MODE_RDONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS ) {
+		throw runtime_error("cannot open " + aFilename);
+	}
+
+	MPI_Offset file_size;
+	MPI_File_get_size(file, &file_size);
+
+	PopulationHeader header;
+	memset(&header, 0, sizeof(header));
+	MPI_File_read_at_all(file, 0, &header, sizeof(header), MPI_BYTE, MPI_STATUS_IGNORE);
+	try {
+		PopulationFile::checkHeader(header, file_size, aFilename);
+	}
+	catch(...) {
+		MPI_File_close(&file);
+		throw;
+	}
+	if( header.n_shards != (uint64_t)n_proc ) {
+		MPI_File_close(&file);
+		return false;
+	}
+
+	// the whole table is checked so that every process fails or succeeds together
+	vector<ShardRecord> shard_table(n_proc);
+	MPI_File_read_at_all(file, header.shard_table_offset, shard_table.data(), n_proc * sizeof(ShardRecord), MPI_BYTE,
+			MPI_STATUS_IGNORE);
+	try {
+		for( auto& s : shard_table ) checkShard(s, header, aFilename);
+	}
+	catch(...) {
+		MPI_File_close(&file);
+		throw;
+	}
+	const ShardRecord& shard = shard_table[rank];
+
+	MPI_Datatype person_type, activity_type;
+	MPI_Type_contiguous(sizeof(PersonRecord), MPI_BYTE, &person_type);
+	MPI_Type_contiguous(sizeof(ActivityRecord), MPI_BYTE, &activity_type);
+	MPI_Type_commit(&person_type);
+	MPI_Type_commit(&activity_type);
+
+	aShard.persons.resize(shard.n_persons);
+	aShard.activities.resize(shard.n_activities);
+	int status_persons = MPI_File_read_at_all(file, header.persons_offset + shard.first_person * sizeof(PersonRecord),
+			aShard.persons.data(), shard.n_persons, person_type, MPI_STATUS_IGNORE);
+	int status_activities = MPI_File_read_at_all(file, header.activities_offset + shard.first_activity * sizeof(ActivityRecord),
+			aShard.activities.data(), shard.n_activities, activity_type, MPI_STATUS_IGNORE);
+
+	MPI_Type_free(&person_type);
+	MPI_Type_free(&activity_type);
+	MPI_File_close(&file);
+
+	if( status_persons != MPI_SUCCESS || status_activities != MPI_SUCCESS ) {
+		throw runtime_error("error while reading " + aFilename);
+	}
+
+	rebaseShard(aShard, header, shard, aFilename);
+	return true;
+
+}
+
+
+bool scatterPopulationShards(const std::string& aFilename, MPI_Comm aComm, PopulationShard& aShard) {
+
+	int rank, n_proc;
+	MPI_Comm_rank(aComm, &rank);
+	MPI_Comm_size(aComm, &n_proc);
+
+	// ... header, checked on the process 0 (status: 0 valid, 1 not sharded for this run, 2 invalid)
+	FILE* file = NULL;
+	PopulationHeader header;
+	memset(&header, 0, sizeof(header));
+	int status = 0;
+	string error;
+	if( rank == 0 ) {
+		try {
+			file = fopen(aFilename.c_str(), "rb");
+			if( file == NULL ) throw runtime_error("cannot open " + aFilename);
+			readAt(file, 0, &header, sizeof(header), 1, aFilename);
+			fseeko(file, 0, SEEK_END);
+			PopulationFile::checkHeader(header, ftello(file), aFilename);
+			if( header.n_shards != (uint64_t)n_proc ) status = 1;
+		}
+		catch(const std::exception& ex) {
+			error = ex.what();
+			status = 2;
+		}
+	}
+	MPI_Bcast(&status, 1, MPI_INT, 0, aComm);
+	if( status != 0 ) {
+		if( file != NULL ) fclose(file);
+		if( status == 1 ) return false;
+		throw runtime_error(rank == 0 ? error : aFilename + " could not be read by the process 0");
+	}
+
+	// ... shard table
+	vector<ShardRecord> shard_table;
+	if( rank == 0 ) {
+		shard_table.resize(n_proc);
+		readAt(file, header.shard_table_offset, &shard_table[0], sizeof(ShardRecord), n_proc, aFilename);
+	}
+	ShardRecord shard;
+	MPI_Scatter(shard_table.data(), sizeof(ShardRecord), MPI_BYTE, &shard, sizeof(ShardRecord), MPI_BYTE, 0, aComm);
+	MPI_Bcast(&header, sizeof(header), MPI_BYTE, 0, aComm);
+
+	// ... shards, read and sent one after the other
+	MPI_Datatype person_type, activity_type;
+	MPI_Type_contiguous(sizeof(PersonRecord), MPI_BYTE, &person_type);
+	MPI_Type_contiguous(sizeof(ActivityRecord), MPI_BYTE, &activity_type);
+	MPI_Type_commit(&person_type);
+	MPI_Type_commit(&activity_type);
+
+	if( rank == 0 ) {
+		PopulationShard buffer;
+		try {
+			for( int p = n_proc - 1; p >= 0; p-- ) {
+				const ShardRecord& s = shard_table[p];
+				checkShard(s, header, aFilename);
+				PopulationShard& target = ( p == 0 ) ? aShard : buffer;
+				target.persons.resize(s.n_persons);
+				target.activities.resize(s.n_activities);
+				readAt(file, header.persons_offset + s.first_person * sizeof(PersonRecord), target.persons.data(),
+						sizeof(PersonRecord), s.n_persons, aFilename);
+				readAt(file, header.activities_offset + s.first_activity * sizeof(ActivityRecord), target.activities.data(),
+						sizeof(ActivityRecord), s.n_activities, aFilename);
+				if( p > 0 ) {
+					MPI_Send(buffer.persons.data(), s.n_persons, person_type, p, 0, aComm);
+					MPI_Send(buffer.activities.data(), s.n_activities, activity_type, p, 1, aComm);
+				}
+			}
+		}
+		catch(const std::exception& ex) {
+			// the other processes are waiting for their shard
+			cerr << "ERROR: " << ex.what() << endl;
+			MPI_Abort(aComm, EXIT_FAILURE);
+		}
+		fclose(file);
+	}
+	else {
+		aShard.persons.resize(shard.n_persons);
+		aShard.activities.resize(shard.n_activities);
+		MPI_Recv(aShard.persons.data(), shard.n_persons, person_type, 0, 0, aComm, MPI_STATUS_IGNORE);
+		MPI_Recv(aShard.activities.data(), shard.n_activities, activity_type, 0, 1, aComm, MPI_STATUS_IGNORE);
+	}
+
+	MPI_Type_free(&person_type);
+	MPI_Type_free(&activity_type);
+
+	rebaseShard(aShard, header, shard, aFilename);
+	return true;
+
+}
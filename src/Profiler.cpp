@@ -0,0 +1,178 @@
+/****************************************************************
+ * PROFILER.CPP
+ *
+ * This file contains all the definitions of the methods of
+ * Profiler.hpp (see this file for methods' documentation)
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+#include "../include/Profiler.hpp"
+#include "../include/Data.hpp"
+
+#include <fstream>
+
+using namespace std;
+
+
+StartupProfiler& StartupProfiler::instance() {
+	static StartupProfiler profiler;
+	return profiler;
+}
+
+
+int StartupProfiler::getPhase(const std::string& aName) {
+
+	for( unsigned int i = 0; i < _phases.size(); i++ ) {
+		if( _phases[i].name == aName ) return i;
+	}
+	Phase phase = { aName, 0.0, 0 };
+	_phases.push_back(phase);
+	return _phases.size() - 1;
+
+}
+
+
+void StartupProfiler::start(const std::string& aName) {
+
+	if( _current >= 0 ) stop();
+	_current = getPhase(aName);
+	_nested  = 0.0;
+	_start   = Clock::now();
+
+}
+
+
+void StartupProfiler::stop() {
+
+	if( _current < 0 ) return;
+
+	double time = chrono::duration<double>(Clock::now() - _start).count();
+	long peak_memory = getPeakMemory();
+	_phases[_current].time += time - _nested;
+	_phases[_current].peak_memory = peak_memory;
+
+	// the nested phases end with their parent
+	for( auto& p : _phases ) {
+		if( p.peak_memory < 0 ) p.peak_memory = peak_memory;
+	}
+	_current = -1;
+
+}
+
+
+void StartupProfiler::addNested(const std::string& aName, Clock::time_point aStart) {
+
+	double time = chrono::duration<double>(Clock::now() - aStart).count();
+	int phase = getPhase(aName);
+	_phases[phase].time += time;
+	_phases[phase].peak_memory = -1;
+	_nested += time;
+
+}
+
+
+void StartupProfiler::write(const std::string& aFilename) const {
+
+	ofstream out(aFilename.c_str());
+	if( !out ) {
+		cerr << "ERROR: cannot write " << aFilename << endl;
+		return;
+	}
+
+	out << "phase;time;peak_memory" << endl;
+	for( const auto& p : _phases ) {
+		out << p.name << ";" << p.time << ";" << p.peak_memory << endl;
+	}
+
+}
+
+
+//! Names of the step phases in the outputs.
+static const char* STEP_PHASE_NAMES[N_STEP_PHASES] = { "progression", "location", "query", "infection", "activity",
+		"gather", "record", "balance", "sync" };
+
+
+StepProfiler::StepProfiler() : _enabled(false), _sampling(1), _counter(0), _start_cycles(0), _start(), _intervals() {
+	Phase none = {};
+	for( int p = 0; p < N_STEP_PHASES; p++ ) _phases[p] = _last[p] = none;
+}
+
+
+StepProfiler& StepProfiler::instance() {
+	static StepProfiler profiler;
+	return profiler;
+}
+
+
+void StepProfiler::enable(unsigned int aSampling, const std::string& aIntervalsFilename) {
+
+	_sampling = 1;
+	while( _sampling < aSampling ) _sampling *= 2;
+
+	if( !aIntervalsFilename.empty() ) {
+		_intervals.open(aIntervalsFilename.c_str());
+		if( _intervals ) _intervals << "interval;phase;calls;time" << endl;
+		else             cerr << "ERROR: cannot write " << aIntervalsFilename << endl;
+	}
+
+	_enabled      = true;
+	_start        = Clock::now();
+	_start_cycles = cycles();
+
+}
+
+
+double StepProfiler::getSecondsPerCycle() const {
+
+	// the time stamp counter calibrated on the steady clock since the profiler was enabled
+	double seconds = chrono::duration<double>(Clock::now() - _start).count();
+	uint64_t elapsed = cycles() - _start_cycles;
+	return elapsed > 0 ? seconds / elapsed : 0.0;
+
+}
+
+
+void StepProfiler::writeInterval(int aInterval) {
+
+	if( !_enabled || !_intervals.is_open() ) return;
+
+	double seconds_per_cycle = getSecondsPerCycle();
+	for( int p = 0; p < N_STEP_PHASES; p++ ) {
+		_intervals << aInterval << ";" << STEP_PHASE_NAMES[p] << ";" << _phases[p].calls - _last[p].calls << ";"
+				<< (_phases[p].cycles - _last[p].cycles) * seconds_per_cycle << "\n";
+		_last[p] = _phases[p];
+	}
+	_intervals.flush();
+
+}
+
+
+void StepProfiler::write(const std::string& aFilename) const {
+
+	if( !_enabled ) return;
+
+	ofstream out(aFilename.c_str());
+	string hist_filename = aFilename.substr(0, aFilename.rfind(".csv")) + "_hist.csv";
+	ofstream hist(hist_filename.c_str());
+	if( !out || !hist ) {
+		cerr << "ERROR: cannot write " << aFilename << endl;
+		return;
+	}
+
+	double seconds_per_cycle = getSecondsPerCycle();
+	out << "phase;calls;time;mean_time" << endl;
+	hist << "phase;min_cycles;count" << endl;
+	for( int p = 0; p < N_STEP_PHASES; p++ ) {
+		const Phase& phase = _phases[p];
+		double time = phase.cycles * seconds_per_cycle;
+		out << STEP_PHASE_NAMES[p] << ";" << phase.calls << ";" << time << ";" << (phase.calls > 0 ? time / phase.calls : 0.0) << endl;
+
+		// ... the bucket b holding the durations in [2^(b-1), 2^b[ cycles
+		for( int b = 0; b < N_BUCKETS; b++ ) {
+			if( phase.histogram[b] == 0 ) continue;
+			hist << STEP_PHASE_NAMES[p] << ";" << (b == 0 ? 0 : (uint64_t)1 << (b - 1)) << ";" << phase.histogram[b] << endl;
+		}
+	}
+
+}
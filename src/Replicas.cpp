@@ -0,0 +1,43 @@
+/****************************************************************
+ * REPLICAS.CPP
+ *
+ * This file contains all the definitions of the methods of
+ * Replicas.hpp (see this file for methods' documentation)
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+#include "../include/Replicas.hpp"
+
+using namespace std;
+
+
+uint64_t LaneBernoulli::draw(uint64_t aLanes) const {
+
+	if( aLanes == 0 || _p <= 0 ) return 0;
+	if( _p >= 1 ) return aLanes;
+
+	repast::Random* random = repast::Random::instance();
+	uint64_t success = 0;
+
+	// one draw per lane
+	int n_lanes = __builtin_popcountll(aLanes);
+	if( 4 * (REPLICA_LANES * _p + 1) >= n_lanes ) {
+		while( aLanes != 0 ) {
+			uint64_t bit = aLanes & (~aLanes + 1);
+			if( random->nextDouble() < _p ) success |= bit;
+			aLanes ^= bit;
+		}
+		return success;
+	}
+
+	// ... or the geometric gaps between the successes over all the lanes
+	double lane = -1;
+	while( true ) {
+		lane += 1 + floor(log(1 - random->nextDouble()) / _log_q);
+		if( lane >= REPLICA_LANES ) break;
+		success |= (uint64_t)1 << (int)lane;
+	}
+	return success & aLanes;
+
+}
@@ -2,8 +2,67 @@
 #include "../include/Model.hpp"
 #include <random>
 
+///////////////////
+// AgendaBuilder //
+///////////////////
+
+AgendaBuilder::AgendaBuilder(int aProc, Model& aModel) :
+	_proc(aProc), _model(aModel), _sample_size(aModel.getSampleSize()), _sample_seed(aModel.getSampleSeed()), _id(0), _age_cl(0), _gender(0), _socio_pro_status(0), _edu_level(0),
+	_agenda(), _in_person(false), _rejected(false), _house_id(-1), _n_persons(0), _n_kept(0) {
+}
+
+void AgendaBuilder::beginPerson(int aId, int aAgeCl, char aGender, char aSocioProStatus, char aEduLevel) {
+
+	_id               = aId;
+	_age_cl           = aAgeCl;
+	_gender           = aGender;
+	_socio_pro_status = aSocioProStatus;
+	_edu_level        = aEduLevel;
+	_agenda.clear();
+	_in_person        = true;
+	_rejected         = !isSampled(aId, _sample_size, _sample_seed);   // sample.size input parameter
+	_n_persons++;
+
+}
+
+void AgendaBuilder::addActivity(char aType, int aNodeId, int aEndTime, int aDuration) {
+
+	if( !wantsActivities() ) return;
+
+	_agenda.push_back(buildActivity(aType, aNodeId, aEndTime, aDuration, _house_id));
+
+	// the person is kept if its first activity takes place on the current proc
+	if( _agenda.size() == 1 && _model.getNodeProcess(_agenda.front().getNodeId()) != _proc ) {
+		_rejected = true;
+	}
+
+}
+
+void AgendaBuilder::endPerson() {
+
+	if( wantsActivities() && !_agenda.empty() ) {
+
+		repast::AgentId repast_id(_id, _proc, MODEL_AGENT_IND_TYPE, _proc);
+		Individual* ind = new Individual(repast_id, _agenda, 0, _age_cl, _gender, _socio_pro_status, _edu_level,
+				state_inf::SUSCEPTIBLE, 0);
+		auto insertion_start = StartupProfiler::now();
+		_model.addAgent(ind);
+		_model.moveAgentToNode(repast_id, _agenda.front().getNodeId());
+		StartupProfiler::instance().addNested("agents_insertion", insertion_start);
+		_n_kept++;
+
+	}
+	_in_person = false;
+
+}
+
+
+/////////////////
+// VBSaxParser //
+/////////////////
+
 VBSaxParser::VBSaxParser(int aProc, Model& aModel)
-: xmlpp::SaxParser(), _proc(aProc), _model(aModel) {
+: xmlpp::SaxParser(), _proc(aProc), _builder(aProc, aModel) {
 }
 
 VBSaxParser::~VBSaxParser() {
@@ -17,47 +76,28 @@ void VBSaxParser::on_end_document() {
 	std::cout << "Parsing xml done" << std::endl;
 }
 
-//Error while parsing the xml file: rewrite this function, otherwise we miss the last individual
-//maybe playing in the part with activity: when generating an activity:
-//     -> look if first
-//     -> adding the ind to the context
 void VBSaxParser::on_start_element(const Glib::ustring& name, const AttributeList& attributes) {
 
-	static Individual* cur_ind = NULL;
-
 	if( name.compare("person") == 0 ) {
-		cur_ind = on_individual(attributes);
+		on_individual(attributes);
 	}
 
 	// generating the agenda of the current individual
-	if( name.compare("act") == 0 ) {
-		on_activity(attributes, cur_ind);
-
-		// if activity = m and associated node belongs to the current proc, add the agent to the context
-		if( _model.getMapNodeProcess().at(cur_ind->getHouseNodeId()) == _proc
-				&& cur_ind->getAgenda().size() == 1) {
-		  
-		  // keeping only a proportion of the agents defined by the sample.size input parameter
-		  if ( repast::Random::instance()->nextDouble() < _model.getSampleSize() ) {
-			_model.addAgent(cur_ind);
-			_model.moveAgentToNode(cur_ind->getId(),cur_ind->getHouseNodeId());
-		  }
-			
-		}
-
+	else if( name.compare("act") == 0 && _builder.wantsActivities() ) {
+		on_activity(attributes);
 	}
 
 }
 
-Individual* VBSaxParser::on_individual(const AttributeList &attributes) {
+void VBSaxParser::on_individual(const AttributeList &attributes) {
 
 	// reading the agents attributes
 
-	int id;
-	int age_cl;
-	char gender;
-	char socio_pro_status;
-	char edu_level;
+	int id = 0;
+	int age_cl = 0;
+	char gender = 0;
+	char socio_pro_status = 0;
+	char edu_level = 0;
 
 	for(xmlpp::SaxParser::AttributeList::const_iterator iter = attributes.begin(); iter != attributes.end(); ++iter) {
 		if(iter->name.raw().compare("id")         == 0) id               = boost::lexical_cast<int>(iter->value.raw());
@@ -67,25 +107,17 @@ Individual* VBSaxParser::on_individual(const AttributeList &attributes) {
 		if(iter->name.raw().compare("sps_status") == 0) socio_pro_status = boost::lexical_cast<char>(iter->value.raw());
 	}
 
-	// creating agent_id
-	repast::AgentId repast_id(id, _proc, MODEL_AGENT_IND_TYPE, _proc);
-
-	// creating the agent
-	Individual *cur_ind = new Individual(repast_id,age_cl,gender,socio_pro_status,edu_level);
-
-	return cur_ind;
+	_builder.beginPerson(id, age_cl, gender, socio_pro_status, edu_level);
 
 }
 
-void VBSaxParser::on_activity(const AttributeList &attributes, Individual *ind ) {
+void VBSaxParser::on_activity(const AttributeList &attributes) {
 
-	char type;
+	char type = 0;
 	int node_id = -1; // -1 indicates that it is the last activity of the day, ie return to home
 	int duration = -1;
 	int end_time = -1;
 
-	static int house_id = -1;
-
 	for(xmlpp::SaxParser::AttributeList::const_iterator iter = attributes.begin(); iter != attributes.end(); ++iter) {
 		if(iter->name.compare("type")     == 0) type     = boost::lexical_cast<char>(iter->value.raw());
 		if(iter->name.compare("end_time") == 0) end_time = timeToSec(iter->value.raw());
@@ -93,36 +125,44 @@ void VBSaxParser::on_activity(const AttributeList &attributes, Individual *ind )
 		if(iter->name.compare("node_id")  == 0) node_id  = boost::lexical_cast<int>(iter->value.raw());
 	}
 
-	int start_time = end_time - duration;
+	_builder.addActivity(type, node_id, end_time, duration);
+
+}
+
+Activity buildActivity(char aType, int aNodeId, int aEndTime, int aDuration, int& aHouseId) {
+
+	int start_time = aEndTime - aDuration;
 	while( start_time < 0 ) {
 		start_time = start_time + 86400;
 	}
 
 	// determine the node id (transforming the original id)
+	int node_id = aNodeId;
 	if( node_id != -1 ) {
 		node_id = Data::getInstance()->getMapNodesOrigIdNewId().at(node_id);
 	}
 
 	// determine the house id
-	if( node_id != -1 && type == 'm' ) {
-		house_id = node_id;
+	if( node_id != -1 && aType == 'm' ) {
+		aHouseId = node_id;
 	}
 	if( node_id == -1 ) {
-		node_id = house_id;
+		node_id = aHouseId;
 	}
-	if( end_time == -1 ) {
+	if( aEndTime == -1 ) {
 		start_time = -1;
 	}
 
-	// creating the activity
-	Activity cur_act(node_id, start_time, end_time, type);
-
-	// adding it to the individual
-	ind->addActivity(cur_act);
+	return Activity(node_id, start_time, aEndTime, aType);
 
 }
 
 void VBSaxParser::on_end_element(const Glib::ustring& name) {
+
+	if( name.compare("person") == 0 ) {
+		_builder.endPerson();
+	}
+
 }
 
 void VBSaxParser::on_characters(const Glib::ustring& text) {
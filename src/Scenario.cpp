@@ -0,0 +1,66 @@
+/****************************************************************
+ * SCENARIO.CPP
+ *
+ * This file contains all the definitions of the methods of
+ * Scenario.hpp (see this file for methods' documentation)
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+#include "../include/Scenario.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <boost/algorithm/string.hpp>
+
+using namespace std;
+
+
+//! Split a line of the table on ';', trimming the values.
+static vector<string> splitLine(const string& aLine) {
+	vector<string> values;
+	boost::algorithm::split(values, aLine, boost::algorithm::is_any_of(";"));
+	for( auto& v : values ) boost::algorithm::trim(v);
+	return values;
+}
+
+
+ScenarioTable::ScenarioTable(const std::string& aFilename) : _keys(), _rows(), _name(-1) {
+
+	ifstream in(aFilename.c_str());
+	if( !in ) throw runtime_error("cannot open " + aFilename);
+
+	string line;
+	int n_line = 0;
+	while( getline(in, line) ) {
+		n_line++;
+		boost::algorithm::trim(line);
+		if( line.empty() || line[0] == '#' ) continue;
+
+		vector<string> values = splitLine(line);
+		if( _keys.empty() ) {
+			_keys = values;
+			for( unsigned int k = 0; k < _keys.size(); k++ ) {
+				if( _keys[k] == "scenario" ) _name = k;
+			}
+		} else if( values.size() != _keys.size() ) {
+			throw runtime_error(aFilename + ":" + to_string(n_line) + ": " + to_string(_keys.size()) + " values expected");
+		} else {
+			_rows.push_back(values);
+		}
+	}
+
+}
+
+
+std::string ScenarioTable::getName(size_t aScenario) const {
+	if( _name >= 0 ) return _rows[aScenario][_name];
+	return "scenario_" + to_string(aScenario + 1);
+}
+
+
+void ScenarioTable::apply(size_t aScenario, repast::Properties& aProps) const {
+	for( unsigned int k = 0; k < _keys.size(); k++ ) {
+		if( (int)k != _name ) aProps.putProperty(_keys[k], _rows[aScenario][k]);
+	}
+}
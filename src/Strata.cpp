@@ -0,0 +1,154 @@
+/****************************************************************
+ * STRATA.CPP
+ *
+ * This file contains all the definitions of the methods of
+ * Strata.hpp (see this file for methods' documentation)
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+#include "../include/Strata.hpp"
+#include "../include/Data.hpp"
+
+#include <stdexcept>
+#include <boost/mpi/collectives.hpp>
+#include <boost/serialization/set.hpp>
+#include <boost/serialization/vector.hpp>
+
+using namespace std;
+
+
+StrataCounts::StrataCounts(const repast::Properties& aProps, const std::string& aFilename, int aInterval, int aProc) :
+	_dims(), _n_strata(1), _counts(), _activity(false), _interval(aInterval), _proc(aProc), _out() {
+
+	vector<string> names = split<string>(aProps.getProperty("output.strata"), ",");
+	for( const auto& name : names ) {
+
+		Dimension dim;
+		dim.name = name;
+		if( name == "age_cl" )          dim.attribute = STRATA_AGE_CL;
+		else if( name == "gender" )     dim.attribute = STRATA_GENDER;
+		else if( name == "sps_status" ) dim.attribute = STRATA_SPS_STATUS;
+		else if( name == "edu_level" )  dim.attribute = STRATA_EDU_LEVEL;
+		else if( name == "activity" )   dim.attribute = STRATA_ACTIVITY;
+		else throw runtime_error("unknown attribute in output.strata: " + name);
+		_activity = _activity || dim.attribute == STRATA_ACTIVITY;
+
+		// values given in the properties, the age classes being numbers and the other attributes characters
+		string values = aProps.getProperty("output.strata." + name);
+		for( const auto& v : split<string>(values, ",") ) {
+			dim.values.push_back(dim.attribute == STRATA_AGE_CL ? boost::lexical_cast<int>(v) : (int)v[0]);
+		}
+		_dims.push_back(dim);
+
+	}
+
+	if( _proc == 0 ) {
+		_out.open(aFilename.c_str());
+		if( !_out ) throw runtime_error("cannot create " + aFilename);
+		_out << "\"tick\";\"state\"";
+		for( const auto& d : _dims ) _out << ";\"" << d.name << "\"";
+		_out << ";\"count\"" << endl;
+	}
+
+}
+
+
+int StrataCounts::getValue(const Individual& aInd, StrataAttribute aAttribute) {
+
+	switch( aAttribute ) {
+	case STRATA_AGE_CL:     return aInd.getAgeCl();
+	case STRATA_GENDER:     return aInd.getGender();
+	case STRATA_SPS_STATUS: return aInd.getSocioProStatus();
+	case STRATA_EDU_LEVEL:  return aInd.getEduLevel();
+	default:
+		if( aInd.getAgenda().empty() ) return -1;
+		return aInd.getAgenda()[aInd.getCurAct()].getType();
+	}
+
+}
+
+
+void StrataCounts::collectValues(const Individual& aInd, std::vector<std::set<int> >& aValues) const {
+
+	for( unsigned int d = 0; d < _dims.size(); d++ ) {
+		if( !_dims[d].values.empty() ) continue;
+		if( _dims[d].attribute == STRATA_ACTIVITY ) {
+			for( const auto& a : aInd.getAgenda() ) aValues[d].insert(a.getType());
+		} else {
+			aValues[d].insert(getValue(aInd, _dims[d].attribute));
+		}
+	}
+
+}
+
+
+void StrataCounts::setup(std::vector<std::set<int> >& aValues, const boost::mpi::communicator& aComm) {
+
+	// the values taken on any process, so that every process has the same strata
+	vector<vector<set<int> > > all_values;
+	boost::mpi::all_gather(aComm, aValues, all_values);
+
+	_n_strata = 1;
+	for( int d = _dims.size() - 1; d >= 0; d-- ) {
+		Dimension& dim = _dims[d];
+		if( dim.values.empty() ) {
+			set<int> values;
+			for( const auto& v : all_values ) values.insert(v[d].begin(), v[d].end());
+			dim.values.assign(values.begin(), values.end());
+		}
+		for( unsigned int i = 0; i < dim.values.size(); i++ ) dim.index[dim.values[i]] = i;
+
+		// ... one more stratum for the values not listed
+		dim.stride = _n_strata;
+		_n_strata *= dim.values.size() + 1;
+	}
+	_counts.assign(N_STATES * _n_strata, 0);
+
+	if( _proc == 0 ) cout << "INFO: Proc " << _proc << ": " << _n_strata << " strata" << endl;
+
+}
+
+
+int StrataCounts::getStratum(const Individual& aInd) const {
+
+	int stratum = 0;
+	for( const auto& d : _dims ) {
+		auto it = d.index.find(getValue(aInd, d.attribute));
+		stratum += (it != d.index.end() ? it->second : d.values.size()) * d.stride;
+	}
+	return stratum;
+
+}
+
+
+void StrataCounts::write(double aTick, const boost::mpi::communicator& aComm) {
+
+	// a single reduction of all the counts
+	if( _proc != 0 ) {
+		MPI_Reduce(_counts.data(), NULL, _counts.size(), MPI_INT, MPI_SUM, 0, aComm);
+		return;
+	}
+	vector<int> counts(_counts.size());
+	MPI_Reduce(_counts.data(), counts.data(), _counts.size(), MPI_INT, MPI_SUM, 0, aComm);
+
+	// one row per non empty stratum
+	static const char* states[N_STATES] = { "susceptible", "latent", "symptomatic", "asymptomatic", "recovered" };
+	for( int s = 0; s < N_STATES; s++ ) {
+		for( int stratum = 0; stratum < _n_strata; stratum++ ) {
+			int count = counts[s * _n_strata + stratum];
+			if( count == 0 ) continue;
+			_out << aTick << ";" << states[s];
+			for( const auto& d : _dims ) {
+				unsigned int v = (stratum / d.stride) % (d.values.size() + 1);
+				_out << ";";
+				if( v == d.values.size() )              _out << "other";
+				else if( d.attribute == STRATA_AGE_CL ) _out << d.values[v];
+				else                                    _out << (char)d.values[v];
+			}
+			_out << ";" << count << "\n";
+		}
+	}
+	_out.flush();
+
+}
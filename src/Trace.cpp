@@ -0,0 +1,141 @@
+/****************************************************************
+ * TRACE.CPP
+ *
+ * This file contains all the definitions of the methods of
+ * Trace.hpp (see this file for methods' documentation)
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+#include "../include/Trace.hpp"
+
+#include <climits>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+
+//! Number of pings of every process to estimate the offset of its clock.
+static const int N_CLOCK_PINGS = 16;
+
+
+TraceRecorder& TraceRecorder::instance() {
+	static TraceRecorder recorder;
+	return recorder;
+}
+
+
+void TraceRecorder::synchronizeClocks(MPI_Comm aComm) {
+
+	int rank, size;
+	MPI_Comm_rank(aComm, &rank);
+	MPI_Comm_size(aComm, &size);
+	_offset = 0;
+
+	// the processes are synchronized one after the other on the process 0
+	for( int p = 1; p < size; p++ ) {
+		if( rank == 0 ) {
+			for( int i = 0; i < N_CLOCK_PINGS; i++ ) {
+				MPI_Recv(NULL, 0, MPI_BYTE, p, 0, aComm, MPI_STATUS_IGNORE);
+				int64_t time = now();
+				MPI_Send(&time, 1, MPI_INT64_T, p, 0, aComm);
+			}
+		}
+		else if( rank == p ) {
+			int64_t shortest = numeric_limits<int64_t>::max();
+			int64_t offset = 0;
+			for( int i = 0; i < N_CLOCK_PINGS; i++ ) {
+				int64_t sent = now();
+				int64_t time;
+				MPI_Send(NULL, 0, MPI_BYTE, 0, 0, aComm);
+				MPI_Recv(&time, 1, MPI_INT64_T, 0, 0, aComm, MPI_STATUS_IGNORE);
+				int64_t received = now();
+
+				// ... the process 0 answering halfway through the round trip
+				if( received - sent < shortest ) {
+					shortest = received - sent;
+					offset = time - (sent + received) / 2;
+				}
+			}
+			_offset = offset;
+		}
+	}
+
+}
+
+
+void TraceRecorder::enable(size_t aCapacity, int aSampling, int aFrom, int aTo, MPI_Comm aComm) {
+
+	_events.resize(max(aCapacity, (size_t)1));
+	_n_events = 0;
+	_sampling  = max(aSampling, 1);
+	_countdown = _sampling;
+	_from     = aFrom;
+	_to       = aTo;
+	synchronizeClocks(aComm);
+
+	// ... the times starting when the process 0 is synchronized
+	int64_t origin = now();
+	MPI_Bcast(&origin, 1, MPI_INT64_T, 0, aComm);
+	_offset -= origin;
+	_enabled  = true;
+
+}
+
+
+void TraceRecorder::write(const std::string& aFilename, MPI_Comm aComm, int aRank) const {
+
+	int rank, size;
+	MPI_Comm_rank(aComm, &rank);
+	MPI_Comm_size(aComm, &size);
+
+	// events of the process, in the order they ended, as trace events with their times in us
+	string events;
+	char line[512];
+	uint64_t n_kept = min<uint64_t>(_n_events, _events.size());
+	for( uint64_t i = _n_events - n_kept; i < _n_events; i++ ) {
+		const Event& e = _events[i % _events.size()];
+		snprintf(line, sizeof(line), ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":0,\"args\":{\"tick\":%d}}",
+				e.name, e.category, e.begin / 1000.0, (e.end - e.begin) / 1000.0, aRank, e.tick);
+		events += line;
+	}
+	snprintf(line, sizeof(line), ",\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"Proc %d\"}}"
+			",\n{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"sort_index\":%d}}", aRank, aRank, aRank, aRank);
+	events += line;
+	if( _n_events > n_kept ) {
+		cout << "INFO: Proc " << aRank << ": " << _n_events - n_kept << " trace events dropped (log.trace.buffer too small)" << endl;
+	}
+
+	// ... the process 0 starting the file, the leading comma of its first event being skipped, and the last one ending it
+	if( rank == 0 ) events.replace(0, 1, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+	if( rank == size - 1 ) events += "\n]}\n";
+
+	// every process writing its events after the ones of the previous processes (64 bits offsets)
+	uint64_t length = events.size();
+	uint64_t offset = 0;
+	MPI_Exscan(&length, &offset, 1, MPI_UINT64_T, MPI_SUM, aComm);
+	if( rank == 0 ) offset = 0;
+
+	MPI_File file;
+	if( MPI_File_open(aComm, const_cast<char*>(aFilename.c_str()), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL,
+			&file) != MPI_SUCCESS ) {
+		if( rank == 0 ) cerr << "ERROR: Proc " << aRank << ": cannot write " << aFilename << endl;
+		return;
+	}
+	MPI_File_set_size(file, 0);
+	MPI_Barrier(aComm);
+
+	// ... in chunks of less than INT_MAX bytes
+	int status = MPI_SUCCESS;
+	for( uint64_t written = 0; written < length && status == MPI_SUCCESS; ) {
+		int chunk = (int)min<uint64_t>(length - written, INT_MAX / 2);
+		status = MPI_File_write_at(file, (MPI_Offset)(offset + written), const_cast<char*>(events.data() + written), chunk,
+				MPI_CHAR, MPI_STATUS_IGNORE);
+		written += chunk;
+	}
+	MPI_File_close(&file);
+	if( status != MPI_SUCCESS ) cerr << "ERROR: Proc " << aRank << ": cannot write " << aFilename << endl;
+
+}
@@ -0,0 +1,116 @@
+/****************************************************************
+ * TRANSMISSIONLOG.CPP
+ *
+ * This file contains all the definitions of the methods of
+ * TransmissionLog.hpp (see this file for methods' documentation)
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+#include "../include/TransmissionLog.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+
+TransmissionLog::TransmissionLog(const std::string& aFilename, int aRank, int aNProc, size_t aBufferSize, int aNBuffers) :
+	_filename(aFilename), _file(NULL), _buffers(aNBuffers, vector<TransmissionRecord>(aBufferSize)), _sizes(aNBuffers, 0),
+	_free(), _full(), _current(0), _n_current(0), _n_records(0), _stop(false), _error() {
+
+	_file = fopen(aFilename.c_str(), "wb");
+	if( _file == NULL ) {
+		throw runtime_error("cannot create " + aFilename);
+	}
+
+	TransmissionHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, TRANSMISSION_MAGIC, sizeof(header.magic));
+	header.version     = TRANSMISSION_VERSION;
+	header.record_size = sizeof(TransmissionRecord);
+	header.rank        = aRank;
+	header.n_proc      = aNProc;
+	if( fwrite(&header, sizeof(header), 1, _file) != 1 ) {
+		fclose(_file);
+		_file = NULL;
+		throw runtime_error("cannot write " + aFilename);
+	}
+
+	// the padding bytes are written as they are, so they are zeroed once
+	for( auto& b : _buffers ) memset(b.data(), 0, b.size() * sizeof(TransmissionRecord));
+	for( int i = 1; i < aNBuffers; i++ ) _free.push_back(i);
+	_writer = thread(&TransmissionLog::write, this);
+
+}
+
+
+TransmissionLog::~TransmissionLog() {
+
+	try {
+		close();
+	}
+	catch(const std::exception& ex) {
+		cerr << "ERROR: " << ex.what() << endl;
+	}
+
+}
+
+
+void TransmissionLog::submit() {
+
+	unique_lock<mutex> lock(_mutex);
+	_sizes[_current] = _n_current;
+	_full.push_back(_current);
+	_cond_full.notify_one();
+
+	_cond_free.wait(lock, [this] { return !_free.empty(); });
+	_current = _free.front();
+	_free.pop_front();
+	_n_current = 0;
+
+}
+
+
+void TransmissionLog::write() {
+
+	unique_lock<mutex> lock(_mutex);
+	while( true ) {
+
+		_cond_full.wait(lock, [this] { return !_full.empty() || _stop; });
+		if( _full.empty() ) break;
+
+		int buffer = _full.front();
+		_full.pop_front();
+
+		// the file is written without holding the lock
+		lock.unlock();
+		size_t n_written = fwrite(_buffers[buffer].data(), sizeof(TransmissionRecord), _sizes[buffer], _file);
+		lock.lock();
+
+		if( n_written != _sizes[buffer] && _error.empty() ) _error = "error while writing " + _filename;
+		_free.push_back(buffer);
+		_cond_free.notify_one();
+
+	}
+
+}
+
+
+void TransmissionLog::close() {
+
+	if( _file == NULL ) return;
+
+	if( _n_current > 0 ) submit();
+	{
+		lock_guard<mutex> lock(_mutex);
+		_stop = true;
+	}
+	_cond_full.notify_all();
+	_writer.join();
+
+	if( fclose(_file) != 0 && _error.empty() ) _error = "error while writing " + _filename;
+	_file = NULL;
+	if( !_error.empty() ) throw runtime_error(_error);
+
+}
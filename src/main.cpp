@@ -31,6 +31,9 @@
 #include <iomanip>
 #include "../include/Model.hpp"
 #include "../include/Data.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/Trace.hpp"
+#include "../include/Scenario.hpp"
 
 using namespace std;
 using namespace repast;
@@ -49,41 +52,100 @@ void usage() {
 //! Initialize and launch the simulation.
 /*!
  * \param propsFile the file containing VirtualBelgium properties.
+ * \param comm the communicator of the processes running the simulation.
+ * \param group the group of processes running the simulation (see splitWorld).
+ * \param nGroups the number of groups.
  * \param argc the total number of arguments passed to the main function.
  * \param argv the arguments passed to the main function.
  */
-void runSimulation(std::string propsFile, int argc, char ** argv) {
-
-  // Initialization of mpi's world.
-  mpi::communicator world;
+void runSimulation(std::string propsFile, mpi::communicator& comm, int group, int nGroups, int argc, char ** argv) {
 
   // Reading model's properties.
-  Properties props(propsFile, argc, argv, &world);
+  Properties props(propsFile, argc, argv, &comm);
 
   // Timer.
   Timer timer;
   string time;
   timestamp(time);
   props.putProperty("date_time.run", time);
-  props.putProperty("process.count", world.size());
+  props.putProperty("process.count", comm.size());
+  if (nGroups > 1) props.putProperty("process.group", group);
   timer.start();
 
   // Create and initialize the inputs and the model.
   Data::makeInstance(props);
   props.putProperty("data_creation.time", timer.stop());
 
-  Model model(&world, props);
+  Model model(&comm, props);
   props.putProperty("model_init.time", timer.stop());
-  model.initSchedule();
+
+  // Per process breakdown of the initialization
+  string rank = boost::lexical_cast<string>(mpi::communicator().rank());
+  if (props.getProperty("log.startup") == "true") {
+    StartupProfiler::instance().write("../logs/log_startup_" + rank + ".csv");
+  }
+
+  // Per process time of the step phases
+  if (props.getProperty("log.step") == "true") {
+    string sampling = props.getProperty("log.step.sampling");
+    string hourly = props.getProperty("log.step.hourly") == "true" ? "../logs/log_step_hourly_" + rank + ".csv" : "";
+    StepProfiler::instance().enable(sampling.empty() ? 64 : std::max(strToInt(sampling), 1), hourly);
+  }
+
+  // Timeline of the processes over a window of ticks
+  bool trace = props.getProperty("log.trace") == "true";
+  if (trace) {
+    string buffer = props.getProperty("log.trace.buffer");
+    string sampling = props.getProperty("log.trace.sampling");
+    string from = props.getProperty("log.trace.from");
+    string to = props.getProperty("log.trace.to");
+    TraceRecorder::instance().enable(buffer.empty() ? 1000000 : strToInt(buffer), sampling.empty() ? 4096 : strToInt(sampling),
+        from.empty() ? 0 : strToInt(from), to.empty() ? 3600 : strToInt(to), comm);
+  }
 
   // Get the schedule runner and run it, starting the simulation.
-  if (world.rank() == 0) cout << "Starting simulation... " << endl;
   ScheduleRunner & runner = RepastProcess::instance()->getScheduleRunner();
-  runner.run();
+  string scenarios_file = props.getProperty("scenarios.file");
+  if (scenarios_file.empty()) {
+    model.initSchedule();
+    if (comm.rank() == 0) cout << "Starting simulation... " << endl;
+    runner.run();
+  }
+
+  // ... or one run per scenario, all starting from the initialized agents
+  else {
+    ScenarioTable* scenarios = NULL;
+    try {
+      scenarios = new ScenarioTable(scenarios_file);
+    }
+    catch (const std::exception& ex) {
+      cerr << "ERROR: Proc " << comm.rank() << ": " << ex.what() << endl;
+      MPI_Abort(comm, EXIT_FAILURE);
+    }
+    // ... the groups of processes sharing the scenarios
+    for (size_t s = group; s < scenarios->size(); s += nGroups) {
+      string name = scenarios->getName(s);
+      if (comm.rank() == 0) cout << "Starting scenario " << name << " (" << s + 1 << "/" << scenarios->size() << ")... " << endl;
+      scenarios->apply(s, props);
+      model.startScenario(name);
+      model.initSchedule();
+      runner.run();
+      model.endScenario();
+      runner.reset();
+    }
+    delete scenarios;
+  }
   props.putProperty("run.time", timer.stop());
+  if (StepProfiler::instance().isEnabled()) {
+    StepProfiler::instance().write("../logs/log_step_" + rank + ".csv");
+  }
+  if (trace) {
+    string trace_file = nGroups > 1 ? "../logs/trace_group_" + boost::lexical_cast<string>(group) + ".json" : "../logs/trace.json";
+    TraceRecorder::instance().write(trace_file, comm, mpi::communicator().rank());
+  }
 
   // Writing the log file (only for the root process).
-  if (world.rank() == 0) {
+  if (comm.rank() == 0) {
     vector<string> keysToWrite;
     keysToWrite.push_back("date_time.run");              // starting time of the simulation
     keysToWrite.push_back("process.count");              // number of process
@@ -91,7 +153,8 @@ void runSimulation(std::string propsFile, int argc, char ** argv) {
     keysToWrite.push_back("model_init.time");            // time required to initialize the agents
     keysToWrite.push_back("run.time");                   // run time of the simulation
     props.log("root");
-    props.writeToSVFile("../logs/log_simulation.csv", keysToWrite);
+    string log_file = nGroups > 1 ? "../logs/log_simulation_group_" + boost::lexical_cast<string>(group) + ".csv" : "../logs/log_simulation.csv";
+    props.writeToSVFile(log_file, keysToWrite);
   }
 
   // Free the memory.
@@ -100,6 +163,34 @@ void runSimulation(std::string propsFile, int argc, char ** argv) {
 }
 
 
+//! Split the processes in groups sharing the scenarios (see scenarios.groups).
+/*!
+ * \param propsFile the file containing VirtualBelgium properties.
+ * \param world the communicator of all the processes.
+ * \param group the group of the process.
+ * \param nGroups the number of groups.
+ * \param argc the total number of arguments passed to the main function.
+ * \param argv the arguments passed to the main function.
+ * \return the communicator of the group of the process.
+ */
+mpi::communicator splitWorld(std::string propsFile, mpi::communicator& world, int& group, int& nGroups, int argc, char ** argv) {
+
+  Properties props(propsFile, argc, argv, &world);
+  group = 0;
+  nGroups = 1;
+  if (!props.getProperty("scenarios.file").empty() && props.contains("scenarios.groups")) {
+    nGroups = std::max(1, std::min(strToInt(props.getProperty("scenarios.groups")), world.size()));
+  }
+  if (nGroups == 1) return world;
+
+  // ... contiguous ranks, the groups differing by one process at most
+  group = world.rank() * nGroups / world.size();
+  if (world.rank() == 0) cout << "INFO: " << nGroups << " groups of processes sharing the scenarios" << endl;
+  return world.split(group);
+
+}
+
+
 //! Main function.
 /*!
  * \return EXIT_SUCCESS if the simulation's launching is successful, EXIT_FAILURE otherwise.
@@ -109,6 +200,7 @@ int main(int argc, char ** argv) {
   // MPI and simulation variable
   mpi::environment env(argc, argv);   // MPI environment
   mpi::communicator world;            // MPI communicator
+  mpi::communicator comm;             // MPI communicator of the simulation (see splitWorld)
   string config, props;               // configuration and properties files
 
   // Setting the output precision
@@ -126,8 +218,10 @@ int main(int argc, char ** argv) {
 
   // Starting the simulation
   if (config.size() > 0 && props.size() > 0) {
-    RepastProcess::init(config, &world);
-    runSimulation(props, argc, argv);
+    int group, n_groups;
+    comm = splitWorld(props, world, group, n_groups, argc, argv);
+    RepastProcess::init(config, &comm);
+    runSimulation(props, comm, group, n_groups, argc, argv);
   }
   else {
     if (world.rank() == 0) usage();
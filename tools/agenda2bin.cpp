@@ -0,0 +1,178 @@
+/****************************************************************
+ * AGENDA2BIN.CPP
+ *
+ * Converts the MATSim activity chains used by the simulation
+ * into a binary population file (see Population.hpp).
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file agenda2bin.cpp
+ *  \brief Converter from the MATSim activity xml file to the binary population format.
+ *
+ *  The converter reads file.agenda and file.network from the model
+ *  properties, so the node ids mapping is the one of the simulation:
+ *
+ *      cd bin && ./agenda2bin model.props ../data/activity_chains_2001.bin
+ *
+ *  The produced file can then be used directly as file.agenda. With the
+ *  --sample option only the persons sampled with sample.size and
+ *  sample.seed (see isSampled) are written, the file can then be used
+ *  with the same seed and any smaller or equal sample size. With the
+ *  --shards N option the persons are grouped by the process owning their
+ *  home node in a simulation on N processes, so that each process can read
+ *  its own shard (see population.io).
+ */
+
+#include "repast_hpc/RepastProcess.h"
+#include "repast_hpc/Properties.h"
+#include <boost/mpi.hpp>
+#include <boost/lexical_cast.hpp>
+#include <libxml++/libxml++.h>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "../include/Data.hpp"
+#include "../include/SaxParser.hpp"
+#include "../include/Population.hpp"
+#include "../include/InputStream.hpp"
+
+using namespace std;
+using namespace repast;
+
+
+//! SAX parser streaming the persons of a MATSim agenda to a PopulationWriter.
+class AgendaConverter : public xmlpp::SaxParser {
+
+private:
+
+	PopulationWriter&       _writer;
+	double                  _sample_size;
+	uint64_t                _sample_seed;
+	PersonRecord            _person;
+	vector<ActivityRecord>  _activities;
+	bool                    _in_person;
+	int                     _house_id;
+
+public:
+
+	AgendaConverter(PopulationWriter& aWriter, double aSampleSize, uint64_t aSampleSeed) :
+		xmlpp::SaxParser(), _writer(aWriter), _sample_size(aSampleSize), _sample_seed(aSampleSeed),
+		_person(), _activities(), _in_person(false), _house_id(-1) {
+	}
+
+protected:
+
+	virtual void on_start_element(const Glib::ustring& name, const AttributeList& attributes) {
+
+		if( name.compare("person") == 0 ) {
+			_person = PersonRecord();
+			_activities.clear();
+			for( auto iter = attributes.begin(); iter != attributes.end(); ++iter ) {
+				if(iter->name.raw().compare("id")         == 0) _person.id               = boost::lexical_cast<int>(iter->value.raw());
+				if(iter->name.raw().compare("gender")     == 0) _person.gender           = boost::lexical_cast<char>(iter->value.raw());
+				if(iter->name.raw().compare("age_cl")     == 0) _person.age_cl           = boost::lexical_cast<unsigned int>(iter->value.raw());
+				if(iter->name.raw().compare("education")  == 0) _person.edu_level        = boost::lexical_cast<char>(iter->value.raw());
+				if(iter->name.raw().compare("sps_status") == 0) _person.socio_pro_status = boost::lexical_cast<char>(iter->value.raw());
+			}
+			_in_person = isSampled(_person.id, _sample_size, _sample_seed);
+		}
+
+		if( name.compare("act") == 0 && _in_person ) {
+			char type = 0;
+			int node_id = -1;
+			int duration = -1;
+			int end_time = -1;
+			for( auto iter = attributes.begin(); iter != attributes.end(); ++iter ) {
+				if(iter->name.compare("type")     == 0) type     = boost::lexical_cast<char>(iter->value.raw());
+				if(iter->name.compare("end_time") == 0) end_time = timeToSec(iter->value.raw());
+				if(iter->name.compare("duration") == 0) duration = boost::lexical_cast<int>(floor(boost::lexical_cast<float>(iter->value.raw())));
+				if(iter->name.compare("node_id")  == 0) node_id  = boost::lexical_cast<int>(iter->value.raw());
+			}
+			Activity act = buildActivity(type, node_id, end_time, duration, _house_id);
+			ActivityRecord record = ActivityRecord();
+			record.node_id    = act.getNodeId();
+			record.start_time = act.getStartTime();
+			record.end_time   = act.getEndTime();
+			record.type       = act.getType();
+			_activities.push_back(record);
+		}
+
+	}
+
+	virtual void on_end_element(const Glib::ustring& name) {
+		if( name.compare("person") == 0 && _in_person ) {
+			_writer.addPerson(_person, _activities);
+			_in_person = false;
+			if( _writer.getNPersons() % 1000000 == 0 ) {
+				cout << "... " << _writer.getNPersons() << " persons converted" << endl;
+			}
+		}
+	}
+
+};
+
+
+int main(int argc, char ** argv) {
+
+	boost::mpi::environment env(argc, argv);
+	boost::mpi::communicator world;
+
+	bool pre_sample = false;
+	uint64_t n_shards = 1;
+	bool valid = argc >= 3 && world.size() == 1;
+	for( int a = 3; a < argc && valid; a++ ) {
+		if( string(argv[a]) == "--sample" ) {
+			pre_sample = true;
+		} else if( string(argv[a]) == "--shards" && a + 1 < argc ) {
+			n_shards = strtoull(argv[++a], NULL, 10);
+			valid = n_shards > 0;
+		} else {
+			valid = false;
+		}
+	}
+	if( !valid ) {
+		cerr << "usage: agenda2bin model.props output_file [--sample] [--shards N]" << endl;
+		cerr << "  converts file.agenda (mapped on file.network) to a binary population file" << endl;
+		cerr << "  --sample: only keeps the persons sampled with sample.size and sample.seed" << endl;
+		cerr << "  --shards: groups the persons for a simulation on N processes (see population.io)" << endl;
+		return EXIT_FAILURE;
+	}
+
+	RepastProcess::init("", &world);
+	Properties props(argv[1]);
+
+	// node ids mapping of the simulation
+	Data::makeInstance(props);
+	uint64_t n_nodes = Data::getInstance()->getMapNodesOrigIdNewId().size();
+
+	string input_xml_file = props.getProperty("file.agenda");
+	cout << "... converting " << input_xml_file << " to " << argv[2] << endl;
+
+	double sample_size = pre_sample ? boost::lexical_cast<float>(props.getProperty("sample.size")) : 1.0;
+	uint64_t sample_seed = pre_sample ? getSampleSeed(props) : 0;
+
+	try {
+		PopulationWriter writer(argv[2], n_nodes, sample_size, sample_seed, n_shards);
+		AgendaConverter parser(writer, sample_size, sample_seed);
+		parser.set_substitute_entities(true);
+		parseXmlFile(input_xml_file, parser);
+		writer.finish();
+		cout << "... done! " << writer.getNPersons() << " persons written" << endl;
+	}
+	catch(const xmlpp::exception& ex) {
+		cerr << "libxml++ exception: " << ex.what() << endl;
+		return EXIT_FAILURE;
+	}
+	catch(const std::exception& ex) {
+		cerr << "ERROR: " << ex.what() << endl;
+		return EXIT_FAILURE;
+	}
+
+	Data::getInstance()->kill();
+	RepastProcess::instance()->done();
+
+	return EXIT_SUCCESS;
+
+}
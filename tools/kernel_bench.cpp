@@ -0,0 +1,346 @@
+/****************************************************************
+ * KERNEL_BENCH.CPP
+ *
+ * Microbenchmarks of the hot paths of the simulation and of
+ * Repast HPC.
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file kernel_bench.cpp
+ *  \brief Microbenchmarks of the kernels of the simulation step.
+ *
+ *  The benchmark initializes the model from the model properties
+ *  (overridden with key=value arguments), then times in isolation the
+ *  kernels of the simulation step on its agents:
+ *  - Moore2DGridQuery::query on a node holding 1 to 4096 agents (moved
+ *    there, besides the agents already on it, the parameter being the
+ *    number of agents the query returns);
+ *  - SharedDiscreteSpace::moveTo between two nodes;
+ *  - SharedContext::getAgent of random agents;
+ *  - Individual::isLatent with the infection probability of the model;
+ *  - the round trip of an agent through an IndividualPackage (package,
+ *    MPI packed serialization and agent creation);
+ *  - a synchronization of the agents (Model::synch_agents) with N agents
+ *    migrating to the next process, when run on several processes.
+ *
+ *  Every kernel is run bench.repeats times bench.ops times, the median
+ *  time per operation and the allocations per operation being written by
+ *  the process 0 to bench.output (kernel;param;ops;ns_per_op;allocs_per_op),
+ *  e.g. on the synthetic inputs (see data/DATA.md):
+ *
+ *      cd bin && mpirun -np 2 ./kernel_bench model.props file.network=../data/synthetic_network.xml \
+ *          file.agenda=../data/synthetic_population.xml infection.sympt.starting.node=1 \
+ *          infection.asympt.starting.node=1 n.infected.asympt=1 sample.size=1
+ */
+
+#include "repast_hpc/RepastProcess.h"
+#include "repast_hpc/Properties.h"
+#include "repast_hpc/Utilities.h"
+#include <boost/mpi.hpp>
+#include <boost/mpi/packed_iarchive.hpp>
+#include <boost/mpi/packed_oarchive.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <vector>
+#include "../include/Model.hpp"
+#include "../include/Data.hpp"
+
+using namespace std;
+using namespace repast;
+
+
+//! Number of allocations of the thread.
+static thread_local uint64_t n_allocations = 0;
+
+void* operator new(size_t aSize) {
+	n_allocations++;
+	void* p = malloc(aSize > 0 ? aSize : 1);
+	if( p == NULL ) throw bad_alloc();
+	return p;
+}
+
+void operator delete(void* aPtr) noexcept {
+	free(aPtr);
+}
+
+
+//! Microbenchmarks of the kernels of the simulation step on the agents of a model.
+class KernelBench {
+
+private:
+
+	typedef std::chrono::steady_clock Clock;
+
+	//! Result of a kernel.
+	struct Result {
+		string   kernel;          //!< name of the kernel
+		string   param;           //!< parameter of the kernel (e.g. the occupancy of the node)
+		uint64_t ops;             //!< number of operations per repeat
+		double   ns_per_op;       //!< median time per operation in ns
+		double   allocs_per_op;   //!< allocations per operation
+	};
+
+	Model&               _model;     //!< model benchmarked
+	boost::mpi::communicator& _comm; //!< communicator of the processes
+	int                  _repeats;   //!< number of repeats of a kernel
+	uint64_t             _ops;       //!< number of operations per repeat
+	vector<Result>       _results;   //!< results of the kernels
+	mt19937_64           _rng;       //!< random engine of the benchmarks
+
+	//! Return the local agents of the model.
+	vector<Individual*> getLocalAgents() const {
+		vector<Individual*> agents;
+		for( auto it = _model._agents->localBegin(); it != _model._agents->localEnd(); it++ ) agents.push_back(it->get());
+		return agents;
+	}
+
+	//! Return the first node of a process.
+	int getFirstNode(int aProc) const {
+		int first, last;
+		Data::getNodesRange(Data::getInstance()->getMapNodesOrigIdNewId().size(), _comm.size(), aProc, first, last);
+		return first;
+	}
+
+	//! Run a kernel, after a warm up, keeping the median time per operation.
+	/*!
+	  \param aKernel the name of the kernel
+	  \param aParam the parameter of the kernel
+	  \param aOps the number of operations per repeat
+	  \param aOp the operation, called with its index
+	 */
+	template <class Op>
+	void run(const string& aKernel, const string& aParam, uint64_t aOps, Op aOp) {
+
+		for( uint64_t i = 0; i < aOps; i++ ) aOp(i);
+
+		vector<double> times;
+		uint64_t allocations = 0;
+		for( int r = 0; r < _repeats; r++ ) {
+			uint64_t allocations_start = n_allocations;
+			Clock::time_point start = Clock::now();
+			for( uint64_t i = 0; i < aOps; i++ ) aOp(i);
+			times.push_back(chrono::duration<double, nano>(Clock::now() - start).count() / aOps);
+			allocations += n_allocations - allocations_start;
+		}
+		sort(times.begin(), times.end());
+
+		Result result = { aKernel, aParam, aOps, times[times.size() / 2], (double)allocations / (aOps * _repeats) };
+		_results.push_back(result);
+
+	}
+
+public:
+
+	//! Constructor.
+	KernelBench(Model& aModel, boost::mpi::communicator& aComm, int aRepeats, uint64_t aOps) :
+		_model(aModel), _comm(aComm), _repeats(max(aRepeats, 1)), _ops(max(aOps, (uint64_t)1)), _results(), _rng(314155646) {
+	}
+
+	//! Query of the agents on a node of increasing occupancy, as done for every infectious agent.
+	void benchQuery() {
+
+		vector<Individual*> agents = getLocalAgents();
+		Point<int> node(getFirstNode(_comm.rank()), 0);
+		size_t n_moved = 0;
+		for( size_t occupancy = 1; occupancy <= 4096 && occupancy <= agents.size(); occupancy *= 8 ) {
+			for( ; n_moved < occupancy; n_moved++ ) _model._discrete_space->moveTo(agents[n_moved]->getId(), node);
+
+			// ... the node also holding the agents living there
+			vector<Individual*> agents_on_node;
+			_model._moore2DQuery->query(node, 0, true, agents_on_node);
+			size_t n_on_node = agents_on_node.size();
+
+			size_t n_found = 0;
+			run("query", to_string(n_on_node), _ops, [&](uint64_t) {
+				vector<Individual*> agents_on_node;
+				_model._moore2DQuery->query(node, 0, true, agents_on_node);
+				n_found += agents_on_node.size();
+			});
+			if( n_found != n_on_node * _ops * (_repeats + 1) ) cerr << "WARNING: Proc " << _comm.rank() << ": unstable query" << endl;
+		}
+
+	}
+
+	//! Move of an agent between two nodes.
+	void benchMoveTo() {
+
+		vector<Individual*> agents = getLocalAgents();
+		if( agents.empty() ) return;
+		int node = getFirstNode(_comm.rank());
+		vector<int> locations[2] = { { node, 0 }, { node + 1, 0 } };
+		run("moveTo", "2 nodes", _ops, [&](uint64_t i) {
+			_model._discrete_space->moveTo(agents[0]->getId(), locations[i & 1]);
+		});
+
+	}
+
+	//! Lookup of random local agents.
+	void benchGetAgent() {
+
+		vector<AgentId> ids;
+		for( auto a : getLocalAgents() ) ids.push_back(a->getId());
+		if( ids.empty() ) return;
+		shuffle(ids.begin(), ids.end(), _rng);
+		uintptr_t sink = 0;
+		run("getAgent", to_string(ids.size()), _ops, [&](uint64_t i) {
+			sink ^= reinterpret_cast<uintptr_t>(_model._agents->getAgent(ids[i % ids.size()]));
+		});
+		if( sink == 1 ) cout << sink << endl;
+
+	}
+
+	//! Infection draw of a susceptible agent.
+	void benchIsLatent() {
+
+		vector<Individual*> agents = getLocalAgents();
+		if( agents.empty() ) return;
+		Individual& ind = *agents.back();
+		state_inf state = ind.getState();
+		int time = ind.getTimeTransition();
+		float p = _model._r_beta_x_beta;
+		run("isLatent", to_string(p), _ops, [&](uint64_t) {
+			if( ind.isLatent(p) ) ind.setState(state_inf::SUSCEPTIBLE);
+		});
+		ind.setState(state);
+		ind.setTimeTransition(time);
+
+	}
+
+	//! Round trip of an agent through a package, as in the agents exchanges.
+	void benchPackage() {
+
+		vector<Individual*> agents = getLocalAgents();
+		if( agents.empty() ) return;
+		Individual* agent = agents.front();
+		run("package", to_string(agent->getAgenda().size()) + " activities", _ops, [&](uint64_t) {
+			vector<IndividualPackage> out, in;
+			_model.providePackage(agent, out);
+			boost::mpi::packed_oarchive oarchive(_comm);
+			oarchive << out;
+			boost::mpi::packed_iarchive iarchive(_comm, oarchive.size());
+			memcpy(iarchive.address(), oarchive.address(), oarchive.size());
+			iarchive >> in;
+			delete _model.createAgent(in.front());
+		});
+
+	}
+
+	//! Synchronization of the agents with N agents of every process migrating to the next one (collective).
+	void benchSync(const vector<int>& aMigrants) {
+
+		if( _comm.size() < 2 ) return;
+		int next = (_comm.rank() + 1) % _comm.size();
+		Point<int> node(getFirstNode(next), 0);
+		uint64_t rounds = max(_ops / 1000, (uint64_t)5);
+
+		for( int n : aMigrants ) {
+			vector<double> times;
+			uint64_t allocations = 0;
+			for( int r = -1; r < _repeats; r++ ) {
+				double time = 0.0;
+				uint64_t round_allocations = 0;
+				for( uint64_t i = 0; i < rounds; i++ ) {
+
+					// ... the migrants leaving their process, as at the end of their activities
+					vector<Individual*> agents = getLocalAgents();
+					_model._map_agents_to_move_process.clear();
+					for( int a = 0; a < n && a < (int)agents.size(); a++ ) {
+						_model._discrete_space->moveTo(agents[a]->getId(), node);
+						_model._map_agents_to_move_process[agents[a]->getId()] = next;
+					}
+
+					// ... the allocations of the setup and of the barrier not being counted
+					_comm.barrier();
+					uint64_t allocations_start = n_allocations;
+					Clock::time_point start = Clock::now();
+					_model.synch_agents();
+					time += chrono::duration<double, nano>(Clock::now() - start).count();
+					round_allocations += n_allocations - allocations_start;
+
+				}
+				if( r < 0 ) continue;
+
+				// ... the slowest process
+				double max_time;
+				boost::mpi::all_reduce(_comm, time / rounds, max_time, boost::mpi::maximum<double>());
+				times.push_back(max_time);
+				allocations += round_allocations;
+			}
+			sort(times.begin(), times.end());
+
+			Result result = { "synchronizeAgentStatus", to_string(n) + " migrants", rounds, times[times.size() / 2],
+					(double)allocations / (rounds * _repeats) };
+			_results.push_back(result);
+		}
+		_model._map_agents_to_move_process.clear();
+
+	}
+
+	//! Write the results (process 0 only).
+	void write(const string& aFilename) const {
+
+		if( _comm.rank() != 0 ) return;
+		ofstream out(aFilename.c_str());
+		if( !out ) cerr << "ERROR: Proc 0: cannot write " << aFilename << endl;
+		for( ostream* o : { (ostream*)&cout, (ostream*)&out } ) {
+			*o << "kernel;param;ops;ns_per_op;allocs_per_op" << endl;
+			for( const auto& r : _results ) {
+				*o << r.kernel << ";" << r.param << ";" << r.ops << ";" << r.ns_per_op << ";" << r.allocs_per_op << endl;
+			}
+		}
+
+	}
+
+};
+
+
+int main(int argc, char ** argv) {
+
+	boost::mpi::environment env(argc, argv);
+	boost::mpi::communicator world;
+
+	if( argc < 2 ) {
+		if( world.rank() == 0 ) {
+			cerr << "usage: kernel_bench model.props [key=value ...]" << endl;
+			cerr << "  times the kernels of the simulation step on the agents of the model" << endl;
+			cerr << "  (bench.repeats, bench.ops, bench.output: ../logs/kernel_bench.csv)" << endl;
+		}
+		return EXIT_FAILURE;
+	}
+
+	RepastProcess::init("", &world);
+	Properties props(argv[1], argc, argv, &world);
+
+	{
+		Data::makeInstance(props);
+		Model model(&world, props);
+
+		int repeats = props.contains("bench.repeats") ? strToInt(props.getProperty("bench.repeats")) : 5;
+		uint64_t ops = props.contains("bench.ops") ? strtoull(props.getProperty("bench.ops").c_str(), NULL, 10) : 100000;
+		string output = props.contains("bench.output") ? props.getProperty("bench.output") : "../logs/kernel_bench.csv";
+
+		// the synchronization last, the agents changing of process
+		KernelBench bench(model, world, repeats, ops);
+		bench.benchQuery();
+		bench.benchMoveTo();
+		bench.benchGetAgent();
+		bench.benchIsLatent();
+		bench.benchPackage();
+		bench.benchSync({ 0, 16, 256, 4096 });
+		bench.write(output);
+
+		Data::getInstance()->kill();
+	}
+
+	RepastProcess::instance()->done();
+
+	return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,183 @@
+/****************************************************************
+ * MERGE_TRANSMISSIONS.CPP
+ *
+ * Merges the transmission files written by the processes of a
+ * simulation (see TransmissionLog.hpp).
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file merge_transmissions.cpp
+ *  \brief Merger of the per process transmission files.
+ *
+ *  The files of all the processes are merged in a single file sorted by
+ *  tick, infectee and infector, either in the binary transmission format
+ *  (with rank -1 in the header) or as a csv file:
+ *
+ *      cd bin && ./merge_transmissions ../output/transmissions.bin ../output/transmissions_*.bin
+ *      cd bin && ./merge_transmissions --csv ../output/transmissions.csv ../output/transmissions_*.bin
+ *
+ *  Each process file being sorted by tick, the files are streamed and
+ *  merged tick after tick, so the memory used only depends on the number
+ *  of events of a tick.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "../include/TransmissionLog.hpp"
+
+using namespace std;
+
+
+//! Buffered reader of a transmission file.
+class TransmissionReader {
+
+private:
+
+	string                      _filename;
+	FILE*                       _file;
+	vector<TransmissionRecord>  _buffer;
+	size_t                      _pos;
+	size_t                      _size;
+
+	void fill() {
+		_size = fread(_buffer.data(), sizeof(TransmissionRecord), _buffer.size(), _file);
+		if( ferror(_file) ) throw runtime_error("error while reading " + _filename);
+		_pos = 0;
+	}
+
+public:
+
+	TransmissionReader(const string& aFilename, TransmissionHeader& aHeader) :
+		_filename(aFilename), _file(NULL), _buffer(1 << 16), _pos(0), _size(0) {
+
+		_file = fopen(aFilename.c_str(), "rb");
+		if( _file == NULL ) throw runtime_error("cannot open " + aFilename);
+		if( fread(&aHeader, sizeof(aHeader), 1, _file) != 1
+				|| memcmp(aHeader.magic, TRANSMISSION_MAGIC, sizeof(aHeader.magic)) != 0 ) {
+			fclose(_file);
+			throw runtime_error(aFilename + " is not a transmission file");
+		}
+		if( aHeader.version != TRANSMISSION_VERSION || aHeader.record_size != sizeof(TransmissionRecord) ) {
+			fclose(_file);
+			throw runtime_error(aFilename + " has an unsupported version");
+		}
+		fill();
+
+	}
+
+	~TransmissionReader() {
+		fclose(_file);
+	}
+
+	bool done() const {
+		return _pos == _size;
+	}
+
+	const TransmissionRecord& peek() const {
+		return _buffer[_pos];
+	}
+
+	void next() {
+		if( ++_pos == _size && _size == _buffer.size() ) fill();
+	}
+
+};
+
+
+int main(int argc, char ** argv) {
+
+	bool csv = argc >= 2 && string(argv[1]) == "--csv";
+	int first = csv ? 2 : 1;
+	if( argc < first + 2 ) {
+		cerr << "usage: merge_transmissions [--csv] output_file transmissions_0.bin ... transmissions_<n-1>.bin" << endl;
+		cerr << "  merges the transmission files of the processes, sorted by tick, infectee and infector" << endl;
+		cerr << "  --csv: writes a csv file (tick;infector;infectee;node;infector_state) instead of a binary one" << endl;
+		return EXIT_FAILURE;
+	}
+	string output_file = argv[first];
+
+	try {
+
+		// ... inputs, checking that they come from the same simulation
+		vector<TransmissionReader*> readers;
+		vector<bool> ranks;
+		TransmissionHeader header;
+		for( int a = first + 1; a < argc; a++ ) {
+			readers.push_back(new TransmissionReader(argv[a], header));
+			if( ranks.empty() ) ranks.resize(header.n_proc, false);
+			if( header.n_proc != (int32_t)ranks.size() || header.rank < 0 || header.rank >= header.n_proc || ranks[header.rank] ) {
+				throw runtime_error(string(argv[a]) + " does not belong to the same simulation as the previous files");
+			}
+			ranks[header.rank] = true;
+		}
+		if( find(ranks.begin(), ranks.end(), false) != ranks.end() ) {
+			cerr << "WARNING: the files of " << count(ranks.begin(), ranks.end(), false) << " processes are missing" << endl;
+		}
+
+		// ... output
+		ofstream out(output_file.c_str(), ios::binary);
+		if( !out ) throw runtime_error("cannot create " + output_file);
+		if( csv ) {
+			out << "tick;infector;infectee;node;infector_state" << endl;
+		} else {
+			header.rank = -1;
+			out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		}
+
+		// ... merging tick after tick
+		uint64_t n_records = 0;
+		vector<TransmissionRecord> events;
+		while( true ) {
+
+			int32_t tick = 0;
+			bool found = false;
+			for( auto r : readers ) {
+				if( !r->done() && (!found || r->peek().tick < tick) ) {
+					tick = r->peek().tick;
+					found = true;
+				}
+			}
+			if( !found ) break;
+
+			events.clear();
+			for( auto r : readers ) {
+				while( !r->done() && r->peek().tick == tick ) {
+					events.push_back(r->peek());
+					r->next();
+				}
+			}
+			sort(events.begin(), events.end(), [](const TransmissionRecord& a, const TransmissionRecord& b) {
+				return a.infectee < b.infectee || (a.infectee == b.infectee && a.infector < b.infector);
+			});
+
+			if( csv ) {
+				for( const auto& e : events ) {
+					out << e.tick << ";" << e.infector << ";" << e.infectee << ";" << e.node << ";" << (int)e.infector_state << "\n";
+				}
+			} else {
+				out.write(reinterpret_cast<const char*>(events.data()), events.size() * sizeof(TransmissionRecord));
+			}
+			n_records += events.size();
+
+		}
+
+		for( auto r : readers ) delete r;
+		out.close();
+		if( !out ) throw runtime_error("error while writing " + output_file);
+		cout << "... done! " << n_records << " transmission events written to " << output_file << endl;
+
+	}
+	catch(const std::exception& ex) {
+		cerr << "ERROR: " << ex.what() << endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,375 @@
+/****************************************************************
+ * SYNTH_POPULATION.CPP
+ *
+ * Generates a synthetic network and population with the shape
+ * of the real inputs, for benchmarking the simulation.
+ *
+ * Date   : 19 October 2026
+ ****************************************************************/
+
+/*! \file synth_population.cpp
+ *  \brief Generator of a synthetic MATSim network and activity chains.
+ *
+ *  The generator writes a network and the activity chains of a
+ *  population, either as MATSim xml or directly in the binary population
+ *  format, from the properties of synthetic.props (overridden with
+ *  key=value arguments):
+ *
+ *      cd bin && ./synth_population synthetic.props synth.persons=10000000 synth.format=bin
+ *
+ *  The nodes lie on a square grid, their index (hence the process owning
+ *  them in a simulation) following the rows. The homes are drawn with
+ *  lognormal residential weights, the activity locations among a few
+ *  candidates at a lognormal distance with Zipf attractiveness weights
+ *  (the hotspots). The agendas depend on the age class: school for the
+ *  children, work for a share of the adults, and a Poisson number of
+ *  secondary activities. The same properties and seed give the same files.
+ */
+
+#include "repast_hpc/RepastProcess.h"
+#include "repast_hpc/Properties.h"
+#include "repast_hpc/Utilities.h"
+#include <boost/mpi.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "../include/Data.hpp"
+#include "../include/Population.hpp"
+
+using namespace std;
+using namespace repast;
+
+
+//! Return a property, or its default value if it is not set.
+static string getProperty(const Properties& aProps, const string& aKey, const string& aDefault) {
+	return aProps.contains(aKey) ? aProps.getProperty(aKey) : aDefault;
+}
+
+//! Return a time of the day (in seconds) as hh:mm:ss.
+static string secToTime(int aTime) {
+	char time[16];
+	snprintf(time, sizeof(time), "%02d:%02d:%02d", aTime / 3600, (aTime / 60) % 60, aTime % 60);
+	return time;
+}
+
+
+//! An activity of a generated agenda.
+struct SynthActivity {
+	char type;       //!< type of the activity
+	int  node;       //!< index of the node
+	int  end_time;   //!< ending time in seconds since midnight (-1 for the last activity)
+	int  duration;   //!< duration in seconds (-1 for the last activity)
+};
+
+
+//! Generator of the synthetic network and population.
+class SynthGenerator {
+
+private:
+
+	int                          _n_nodes;       //!< number of nodes
+	int                          _width;         //!< number of nodes per row of the grid
+	double                       _spacing;       //!< distance between two neighbour nodes in km
+	double                       _speed;         //!< travel speed in km/h
+	int                          _n_candidates;  //!< number of candidate locations of an activity
+	double                       _commute_median;     //!< median distance to work or school in km
+	double                       _commute_sigma;      //!< sigma of the log of the distance to work or school
+	double                       _secondary_median;   //!< median distance to a secondary activity in km
+	double                       _secondary_sigma;    //!< sigma of the log of the distance to a secondary activity
+	double                       _secondary_mean;     //!< mean number of secondary activities
+	double                       _work_rate;     //!< share of the adults working
+	vector<char>                 _secondary_types;    //!< types of the secondary activities
+	mt19937_64                   _rng;           //!< random engine
+	vector<double>               _attractiveness;     //!< attractiveness of every node
+	discrete_distribution<int>   _homes;         //!< distribution of the homes on the nodes
+	discrete_distribution<int>   _ages;          //!< distribution of the age classes
+	normal_distribution<double>  _normal;        //!< standard normal distribution
+
+	//! Return the node the nearest to a point of the grid (in km).
+	int getNode(double aX, double aY) const {
+		int height = (_n_nodes + _width - 1) / _width;
+		int gx = min(max((int)lround(aX / _spacing), 0), _width - 1);
+		int gy = min(max((int)lround(aY / _spacing), 0), height - 1);
+		if( gy == height - 1 ) gx = min(gx, (_n_nodes - 1) % _width);
+		return gy * _width + gx;
+	}
+
+	//! Return the distance between two nodes in km.
+	double getDistance(int aFrom, int aTo) const {
+		return _spacing * hypot(aFrom % _width - aTo % _width, aFrom / _width - aTo / _width);
+	}
+
+	//! Draw the location of an activity from an origin.
+	/*!
+	  The candidates are drawn at a lognormal distance in a random direction,
+	  the location being chosen among them in proportion to their attractiveness.
+	 */
+	int drawLocation(int aOrigin, double aMedian, double aSigma) {
+		uniform_real_distribution<double> uniform(0.0, 1.0);
+		vector<int> candidates(_n_candidates);
+		double total = 0.0;
+		for( int c = 0; c < _n_candidates; c++ ) {
+			double distance = aMedian * exp(aSigma * _normal(_rng));
+			double angle = 2.0 * M_PI * uniform(_rng);
+			candidates[c] = getNode((aOrigin % _width) * _spacing + distance * cos(angle),
+					(aOrigin / _width) * _spacing + distance * sin(angle));
+			total += _attractiveness[candidates[c]];
+		}
+		double draw = total * uniform(_rng);
+		for( int c = 0; c < _n_candidates; c++ ) {
+			draw -= _attractiveness[candidates[c]];
+			if( draw < 0.0 ) return candidates[c];
+		}
+		return candidates.back();
+	}
+
+	//! Return the travel time between two nodes in seconds.
+	int getTravelTime(int aFrom, int aTo) const {
+		return 300 + (int)(3600.0 * getDistance(aFrom, aTo) / _speed);
+	}
+
+	//! Return a normal draw clamped to an interval.
+	double drawClamped(double aMean, double aSd, double aMin, double aMax) {
+		return min(max(aMean + aSd * _normal(_rng), aMin), aMax);
+	}
+
+public:
+
+	//! Constructor.
+	explicit SynthGenerator(const Properties& aProps) : _normal(0.0, 1.0) {
+
+		_n_nodes          = strToInt(getProperty(aProps, "synth.nodes", "100000"));
+		_spacing          = strToDouble(getProperty(aProps, "synth.spacing", "0.5"));
+		_speed            = strToDouble(getProperty(aProps, "synth.speed", "30"));
+		_n_candidates     = max(strToInt(getProperty(aProps, "synth.candidates", "8")), 1);
+		_commute_median   = strToDouble(getProperty(aProps, "synth.commute.median", "8"));
+		_commute_sigma    = strToDouble(getProperty(aProps, "synth.commute.sigma", "0.9"));
+		_secondary_median = strToDouble(getProperty(aProps, "synth.secondary.median", "3"));
+		_secondary_sigma  = strToDouble(getProperty(aProps, "synth.secondary.sigma", "0.8"));
+		_secondary_mean   = strToDouble(getProperty(aProps, "synth.secondary.mean", "0.8"));
+		_work_rate        = strToDouble(getProperty(aProps, "synth.work.rate", "0.65"));
+		_rng.seed(strtoull(getProperty(aProps, "synth.seed", "1").c_str(), NULL, 10));
+		for( const auto& t : split<string>(getProperty(aProps, "synth.secondary.types", "c,l,o"), ",") ) {
+			if( !t.empty() ) _secondary_types.push_back(t[0]);
+		}
+		if( _n_nodes <= 0 || _spacing <= 0.0 || _speed <= 0.0 || _secondary_types.empty() ) {
+			throw runtime_error("invalid synth.nodes, synth.spacing, synth.speed or synth.secondary.types");
+		}
+		_width = (int)ceil(sqrt((double)_n_nodes));
+
+		// hotspots: Zipf weights of the attractiveness ranks, shuffled over the nodes
+		double skew = strToDouble(getProperty(aProps, "synth.hotspot.skew", "1.0"));
+		vector<int> ranks(_n_nodes);
+		for( int n = 0; n < _n_nodes; n++ ) ranks[n] = n + 1;
+		shuffle(ranks.begin(), ranks.end(), _rng);
+		_attractiveness.resize(_n_nodes);
+		for( int n = 0; n < _n_nodes; n++ ) _attractiveness[n] = pow((double)ranks[n], -skew);
+
+		// residential weights
+		lognormal_distribution<double> residential(0.0, strToDouble(getProperty(aProps, "synth.home.sigma", "1.0")));
+		vector<double> homes(_n_nodes);
+		for( auto& h : homes ) h = residential(_rng);
+		_homes = discrete_distribution<int>(homes.begin(), homes.end());
+
+		// age classes of 10 years
+		vector<double> ages = split<double>(getProperty(aProps, "synth.age.shares",
+				"0.11,0.115,0.125,0.13,0.14,0.135,0.11,0.08,0.045,0.01"), ",");
+		_ages = discrete_distribution<int>(ages.begin(), ages.end());
+
+	}
+
+	//! Return the number of nodes.
+	int getNNodes() const {
+		return _n_nodes;
+	}
+
+	//! Write the network in the MATSim format, the node ids being 1..n.
+	void writeNetwork(const string& aFilename) {
+
+		FILE* out = fopen(aFilename.c_str(), "w");
+		if( out == NULL ) throw runtime_error("cannot create " + aFilename);
+		setvbuf(out, NULL, _IOFBF, 1 << 20);
+
+		uniform_real_distribution<double> jitter(-0.3, 0.3);
+		fprintf(out, "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<network name=\"synthetic\">\n<nodes>\n");
+		for( int n = 0; n < _n_nodes; n++ ) {
+			fprintf(out, "\t<node id=\"%d\" x=\"%.1f\" y=\"%.1f\" />\n", n + 1,
+					1000.0 * _spacing * (n % _width + jitter(_rng)), 1000.0 * _spacing * (n / _width + jitter(_rng)));
+		}
+
+		// ... both directions of the links between neighbour nodes
+		fprintf(out, "</nodes>\n<links capperiod=\"01:00:00\">\n");
+		long link = 1;
+		for( int n = 0; n < _n_nodes; n++ ) {
+			int neighbours[2] = { (n + 1) % _width != 0 ? n + 1 : -1, n + _width };
+			for( int m : neighbours ) {
+				if( m < 0 || m >= _n_nodes ) continue;
+				fprintf(out, "\t<link id=\"%ld\" from=\"%d\" to=\"%d\" length=\"%.1f\" freespeed=\"13.89\" capacity=\"1800\" permlanes=\"1\" modes=\"car\" />\n",
+						link++, n + 1, m + 1, 1000.0 * _spacing);
+				fprintf(out, "\t<link id=\"%ld\" from=\"%d\" to=\"%d\" length=\"%.1f\" freespeed=\"13.89\" capacity=\"1800\" permlanes=\"1\" modes=\"car\" />\n",
+						link++, m + 1, n + 1, 1000.0 * _spacing);
+			}
+		}
+		fprintf(out, "</links>\n</network>\n");
+
+		if( ferror(out) || fclose(out) != 0 ) throw runtime_error("error while writing " + aFilename);
+
+	}
+
+	//! Generate a person and its agenda.
+	void generatePerson(int aId, PersonRecord& aPerson, vector<SynthActivity>& aAgenda) {
+
+		uniform_real_distribution<double> uniform(0.0, 1.0);
+		aPerson = PersonRecord();
+		aPerson.id               = aId;
+		aPerson.age_cl           = _ages(_rng);
+		aPerson.gender           = uniform(_rng) < 0.5 ? 'm' : 'f';
+		aPerson.edu_level        = '1' + min((int)(4 * uniform(_rng)), 3);
+		aPerson.socio_pro_status = '1' + min((int)(5 * uniform(_rng)), 4);
+
+		int home = _homes(_rng);
+		aAgenda.clear();
+		aAgenda.push_back(SynthActivity{ 'm', home, -1, -1 });
+
+		// primary activity: school for the children, work for a share of the adults
+		int location = home;
+		int time = (int)(drawClamped(10.0, 2.0, 7.0, 18.0) * 3600);
+		char primary = 0;
+		if( aPerson.age_cl <= 1 ) primary = 's';
+		else if( aPerson.age_cl <= 6 && uniform(_rng) < _work_rate ) primary = 't';
+		if( primary != 0 ) {
+			int node = drawLocation(home, primary == 's' ? _commute_median / 4 : _commute_median, _commute_sigma);
+			int start = (int)((primary == 's' ? drawClamped(8.5, 0.25, 7.5, 9.5) : drawClamped(8.0, 1.0, 5.0, 12.0)) * 3600);
+			int duration = (int)((primary == 's' ? drawClamped(7.0, 0.5, 4.0, 9.0) : drawClamped(8.5, 1.5, 2.0, 11.0)) * 3600);
+			aAgenda.front().end_time = max(start - getTravelTime(home, node), 60);
+			aAgenda.push_back(SynthActivity{ primary, node, start + duration, duration });
+			location = node;
+			time = aAgenda.back().end_time;
+		}
+
+		// secondary activities, while the day is not over
+		poisson_distribution<int> n_secondary(_secondary_mean);
+		int n = n_secondary(_rng);
+		lognormal_distribution<double> secondary_duration(log(3600.0), 0.6);
+		for( int s = 0; s < n; s++ ) {
+			int node = drawLocation(location, _secondary_median, _secondary_sigma);
+			int duration = min((int)secondary_duration(_rng), 4 * 3600);
+			int start = time + getTravelTime(location, node);
+			if( start + duration + getTravelTime(node, home) > 23 * 3600 ) break;
+			if( aAgenda.size() == 1 ) aAgenda.front().end_time = time;
+			aAgenda.push_back(SynthActivity{ _secondary_types[(size_t)(uniform(_rng) * _secondary_types.size())], node, start + duration, duration });
+			location = node;
+			time = start + duration;
+		}
+
+		// ... the first activity lasting from midnight, the last one back home
+		if( aAgenda.size() > 1 ) {
+			aAgenda.front().duration = aAgenda.front().end_time;
+			aAgenda.push_back(SynthActivity{ 'm', home, -1, -1 });
+		}
+
+	}
+
+};
+
+
+int main(int argc, char ** argv) {
+
+	boost::mpi::environment env(argc, argv);
+	boost::mpi::communicator world;
+
+	if( argc < 2 || world.size() != 1 ) {
+		cerr << "usage: synth_population synthetic.props [key=value ...]" << endl;
+		cerr << "  writes synth.network and synth.agenda (MATSim xml, or binary population with synth.format = bin)" << endl;
+		return EXIT_FAILURE;
+	}
+
+	RepastProcess::init("", &world);
+	Properties props(argv[1], argc, argv);
+
+	try {
+		SynthGenerator generator(props);
+		int n_persons = strToInt(getProperty(props, "synth.persons", "1000000"));
+		string network_file = getProperty(props, "synth.network", "../data/synthetic_network.xml");
+		string agenda_file = getProperty(props, "synth.agenda", "../data/synthetic_population.xml");
+		bool binary = getProperty(props, "synth.format", "xml") == "bin";
+
+		cout << "... writing " << generator.getNNodes() << " nodes to " << network_file << endl;
+		generator.writeNetwork(network_file);
+
+		cout << "... writing " << n_persons << " persons to " << agenda_file << endl;
+		PopulationWriter* writer = NULL;
+		FILE* out = NULL;
+		if( binary ) {
+			writer = new PopulationWriter(agenda_file, generator.getNNodes(), 1.0, 0,
+					strtoull(getProperty(props, "synth.shards", "1").c_str(), NULL, 10));
+		} else {
+			out = fopen(agenda_file.c_str(), "w");
+			if( out == NULL ) throw runtime_error("cannot create " + agenda_file);
+			setvbuf(out, NULL, _IOFBF, 1 << 20);
+			fprintf(out, "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<population>\n");
+		}
+
+		PersonRecord person;
+		vector<SynthActivity> agenda;
+		vector<ActivityRecord> records;
+		for( int p = 1; p <= n_persons; p++ ) {
+			generator.generatePerson(p, person, agenda);
+
+			// ... in the binary format, with the times the simulation derives from the xml (see buildActivity)
+			if( binary ) {
+				records.clear();
+				for( const auto& a : agenda ) {
+					ActivityRecord record = ActivityRecord();
+					record.node_id    = a.node;
+					record.start_time = a.end_time == -1 ? -1 : a.end_time - a.duration;
+					record.end_time   = a.end_time;
+					record.type       = a.type;
+					records.push_back(record);
+				}
+				writer->addPerson(person, records);
+			}
+
+			// ... or as MATSim xml
+			else {
+				fprintf(out, "<person id=\"%d\" gender=\"%c\" age_cl=\"%d\" education=\"%c\" sps_status=\"%c\">\n\t<plan selected=\"yes\">\n",
+						person.id, person.gender, person.age_cl, person.edu_level, person.socio_pro_status);
+				for( size_t a = 0; a < agenda.size(); a++ ) {
+					if( a > 0 ) fprintf(out, "\t\t<leg mode=\"car\" />\n");
+					if( agenda[a].end_time == -1 ) {
+						fprintf(out, "\t\t<act type=\"%c\" node_id=\"%d\" />\n", agenda[a].type, agenda[a].node + 1);
+					} else {
+						fprintf(out, "\t\t<act type=\"%c\" node_id=\"%d\" end_time=\"%s\" duration=\"%d\" />\n", agenda[a].type,
+								agenda[a].node + 1, secToTime(agenda[a].end_time).c_str(), agenda[a].duration);
+					}
+				}
+				fprintf(out, "\t</plan>\n</person>\n");
+			}
+
+			if( p % 1000000 == 0 ) cout << "... " << p << " persons generated" << endl;
+		}
+
+		if( binary ) {
+			writer->finish();
+			delete writer;
+		} else {
+			fprintf(out, "</population>\n");
+			if( ferror(out) || fclose(out) != 0 ) throw runtime_error("error while writing " + agenda_file);
+		}
+		cout << "... done!" << endl;
+	}
+	catch(const std::exception& ex) {
+		cerr << "ERROR: " << ex.what() << endl;
+		return EXIT_FAILURE;
+	}
+
+	RepastProcess::instance()->done();
+
+	return EXIT_SUCCESS;
+
+}